@@ -0,0 +1,52 @@
+#include <stdint.h>
+#include <gbdk/platform.h>
+BANKREF(levels)
+/* the open board */
+const uint8_t level0[10] = {0x02, 0x08, 0x01, 0x01, 0xFF, 0x14, 0x11, 0x00, 0x00, 0x00};
+/* a bar across the middle */
+const uint8_t level1[13] = {0x02, 0x04, 0x01, 0x01, 0xFF, 0x14, 0x11, 0x80, 0x00, 0x00, 0xE0, 0x7F, 0x00};
+/* two pillars */
+const uint8_t level2[37] = {0x02, 0x08, 0x08, 0x02, 0xFF, 0x14, 0x11, 0xF8, 0x0F, 0x00, 0x40, 0x20, 0x00, 0x40, 0x20, 0x00, 0x40, 0x20, 0x00, 0x40, 0x20, 0x00, 0x40, 0x20, 0x00, 0x40, 0x20, 0x00, 0x40, 0x20, 0x00, 0x40, 0x20, 0x00, 0x40, 0x20, 0x00};
+/* the cross */
+const uint8_t level3[43] = {0x02, 0x02, 0x01, 0x02, 0xBF, 0x14, 0x11, 0xFC, 0x1F, 0x00, 0x00, 0x06, 0x00, 0x00, 0x06, 0x00, 0x00, 0x06, 0x00, 0x00, 0x06, 0x00, 0x00, 0x06, 0x00, 0xF0, 0xFF, 0x00, 0x00, 0x06, 0x00, 0x00, 0x06, 0x00, 0x00, 0x06, 0x00, 0x00, 0x06, 0x00, 0x00, 0x06, 0x00};
+/* the box with two doors */
+const uint8_t level4[34] = {0x02, 0x02, 0x01, 0x03, 0xBF, 0x14, 0x11, 0x78, 0x0F, 0x00, 0xE0, 0x7F, 0x00, 0x20, 0x40, 0x00, 0x20, 0x40, 0x00, 0x20, 0x40, 0x00, 0x20, 0x40, 0x00, 0x20, 0x40, 0x00, 0x20, 0x40, 0x00, 0xE0, 0x7F, 0x00};
+/* the four corners */
+const uint8_t level5[34] = {0x02, 0x08, 0x04, 0x03, 0x7F, 0x14, 0x11, 0x3C, 0x1E, 0x00, 0x78, 0xE0, 0x01, 0x08, 0x00, 0x01, 0x08, 0x00, 0x01, 0x08, 0x00, 0x01, 0x08, 0x00, 0x01, 0x08, 0x00, 0x01, 0x08, 0x00, 0x01, 0x78, 0xE0, 0x01};
+/* the pillars */
+const uint8_t level6[22] = {0x02, 0x08, 0x01, 0x04, 0x7F, 0x14, 0x11, 0x24, 0x09, 0x00, 0x10, 0x11, 0x01, 0x10, 0x11, 0x01, 0x10, 0x11, 0x01, 0x10, 0x11, 0x01};
+/* the tunnels */
+const uint8_t level7[19] = {0x02, 0x02, 0x01, 0x04, 0x7F, 0x14, 0x11, 0x88, 0x08, 0x00, 0xFE, 0x7F, 0x00, 0xE0, 0xFF, 0x07, 0xFE, 0x7F, 0x00};
+/* the comb */
+const uint8_t level8[40] = {0x02, 0x0D, 0x01, 0x05, 0x7F, 0x14, 0x11, 0xFF, 0x03, 0x00, 0x90, 0x24, 0x01, 0x90, 0x24, 0x01, 0x90, 0x24, 0x01, 0x90, 0x24, 0x01, 0x90, 0x24, 0x01, 0x90, 0x24, 0x01, 0x90, 0x24, 0x01, 0x90, 0x24, 0x01, 0x90, 0x24, 0x01, 0x90, 0x24, 0x01};
+/* the spiral */
+const uint8_t level9[43] = {0x02, 0x01, 0x01, 0x05, 0x3F, 0x14, 0x11, 0xFC, 0x1F, 0x00, 0xF8, 0xFF, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0xE0, 0x3F, 0x01, 0x20, 0x20, 0x01, 0x20, 0x20, 0x01, 0x20, 0x20, 0x01, 0x20, 0x3F, 0x01, 0x20, 0x00, 0x01, 0x20, 0x00, 0x01, 0xE0, 0xFF, 0x01};
+/* the wide field */
+const uint8_t level10[10] = {0x03, 0x09, 0x01, 0x05, 0x7F, 0x20, 0x14, 0x00, 0x00, 0x00};
+/* the long halls */
+const uint8_t level11[42] = {0x03, 0x09, 0x01, 0x06, 0x3F, 0x20, 0x14, 0x2E, 0xD0, 0x01, 0x00, 0x80, 0x01, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x80, 0x01, 0x00, 0xC0, 0xFF, 0xFF, 0x03, 0xC0, 0xFF, 0xFF, 0x03, 0x00, 0x80, 0x01, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x80, 0x01, 0x00};
+/* the window */
+const uint8_t level12[28] = {0x02, 0x02, 0x01, 0x03, 0x7F, 0x14, 0x11, 0x38, 0x0E, 0x00, 0xF0, 0xF9, 0x00, 0x10, 0x80, 0x00, 0x10, 0x80, 0x00, 0x10, 0x80, 0x00, 0x10, 0x80, 0x00, 0xF0, 0xF9, 0x00};
+/* the stairs */
+const uint8_t level13[25] = {0x02, 0x0C, 0x04, 0x03, 0x7F, 0x14, 0x11, 0x54, 0x05, 0x00, 0x38, 0x00, 0x00, 0xC0, 0x01, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x70, 0x00, 0x00, 0x80, 0x03};
+/* the four rooms */
+const uint8_t level14[49] = {0x02, 0x02, 0x01, 0x04, 0x3F, 0x14, 0x11, 0xF7, 0x77, 0x00, 0x00, 0x06, 0x00, 0x00, 0x06, 0x00, 0x00, 0x06, 0x00, 0x00, 0x06, 0x00, 0x00, 0x06, 0x00, 0x00, 0x06, 0x00, 0xEE, 0x7F, 0x07, 0x00, 0x06, 0x00, 0x00, 0x06, 0x00, 0x00, 0x06, 0x00, 0x00, 0x06, 0x00, 0x00, 0x06, 0x00, 0x00, 0x06, 0x00};
+/* the islands */
+const uint8_t level15[28] = {0x01, 0x0F, 0x01, 0x04, 0x7F, 0x14, 0x11, 0xCC, 0x0C, 0x00, 0x98, 0x99, 0x01, 0x98, 0x99, 0x01, 0x98, 0x99, 0x01, 0x98, 0x99, 0x01, 0x98, 0x99, 0x01, 0x98, 0x99, 0x01};
+/* the maze */
+const uint8_t level16[55] = {0x02, 0x02, 0x08, 0x04, 0x3F, 0x14, 0x11, 0xFF, 0x7F, 0x00, 0x10, 0x10, 0x00, 0x10, 0x10, 0x00, 0x10, 0x10, 0x00, 0x10, 0x11, 0x01, 0x10, 0x11, 0x01, 0x10, 0x11, 0x01, 0x10, 0x11, 0x01, 0x10, 0x11, 0x01, 0x10, 0x11, 0x01, 0x10, 0x11, 0x01, 0x10, 0x11, 0x01, 0x10, 0x11, 0x01, 0x00, 0x01, 0x01, 0x00, 0x01, 0x01, 0x00, 0x01, 0x01};
+/* the tall hall */
+const uint8_t level17[46] = {0x03, 0x03, 0x08, 0x03, 0x7F, 0x18, 0x14, 0xF8, 0x7F, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x99, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00};
+/* the ring */
+const uint8_t level18[34] = {0x02, 0x02, 0x01, 0x04, 0x7F, 0x18, 0x12, 0xF0, 0x0F, 0x00, 0xC0, 0xE7, 0x03, 0x40, 0x00, 0x02, 0x40, 0x00, 0x02, 0x40, 0x3C, 0x02, 0x40, 0x3C, 0x02, 0x40, 0x00, 0x02, 0x40, 0x00, 0x02, 0xC0, 0xE7, 0x03};
+/* the checkers */
+const uint8_t level19[42] = {0x01, 0x01, 0x01, 0x04, 0x7F, 0x1A, 0x14, 0xCC, 0xCC, 0x00, 0x30, 0x33, 0x33, 0x00, 0x30, 0x33, 0x33, 0x00, 0x30, 0x33, 0x33, 0x00, 0x30, 0x33, 0x33, 0x00, 0x30, 0x33, 0x33, 0x00, 0x30, 0x33, 0x33, 0x00, 0x30, 0x33, 0x33, 0x00, 0x30, 0x33, 0x33, 0x00};
+/* the corridors */
+const uint8_t level20[26] = {0x02, 0x02, 0x01, 0x05, 0x7F, 0x20, 0x14, 0x88, 0x88, 0x00, 0xFE, 0xFF, 0xFF, 0x07, 0xE0, 0xFF, 0xFF, 0x7F, 0xFE, 0xFF, 0xFF, 0x07, 0xE0, 0xFF, 0xFF, 0x7F};
+/* the big rooms */
+const uint8_t level21[74] = {0x03, 0x03, 0x01, 0x05, 0x3F, 0x20, 0x14, 0xEF, 0xDF, 0x03, 0x00, 0x04, 0x20, 0x00, 0x00, 0x04, 0x20, 0x00, 0x00, 0x04, 0x20, 0x00, 0x00, 0x04, 0x20, 0x00, 0x00, 0x04, 0x20, 0x00, 0x00, 0x04, 0x20, 0x00, 0x00, 0x04, 0x20, 0x00, 0x00, 0x04, 0x20, 0x00, 0xDE, 0x7F, 0xFF, 0x7B, 0x00, 0x04, 0x20, 0x00, 0x00, 0x04, 0x20, 0x00, 0x00, 0x04, 0x20, 0x00, 0x00, 0x04, 0x20, 0x00, 0x00, 0x04, 0x20, 0x00, 0x00, 0x04, 0x20, 0x00, 0x00, 0x04, 0x20, 0x00};
+/* the pillared hall */
+const uint8_t level22[34] = {0x02, 0x11, 0x01, 0x05, 0x7F, 0x20, 0x14, 0x18, 0x63, 0x00, 0x20, 0x84, 0x10, 0x02, 0x20, 0x84, 0x10, 0x02, 0x20, 0x84, 0x10, 0x02, 0x20, 0x84, 0x10, 0x02, 0x20, 0x84, 0x10, 0x02, 0x20, 0x84, 0x10, 0x02};
+/* the labyrinth */
+const uint8_t level23[82] = {0x02, 0x02, 0x08, 0x06, 0x3F, 0x20, 0x14, 0xFF, 0xFF, 0x03, 0x20, 0x80, 0x00, 0x02, 0x20, 0x80, 0x00, 0x02, 0x20, 0x80, 0x00, 0x02, 0x20, 0x80, 0x00, 0x02, 0x20, 0x84, 0x10, 0x02, 0x20, 0x84, 0x10, 0x02, 0x20, 0x84, 0x10, 0x02, 0x20, 0x84, 0x10, 0x02, 0x20, 0x84, 0x10, 0x02, 0x20, 0x84, 0x10, 0x02, 0x20, 0x84, 0x10, 0x02, 0x20, 0x84, 0x10, 0x02, 0x20, 0x84, 0x10, 0x02, 0x20, 0x84, 0x10, 0x1E, 0x00, 0x04, 0x10, 0x00, 0x00, 0x04, 0x10, 0x00, 0x00, 0x04, 0x10, 0x00, 0x00, 0x04, 0x10, 0x00};
+const uint8_t* const levels[24] = {level0, level1, level2, level3, level4, level5, level6, level7, level8, level9, level10, level11, level12, level13, level14, level15, level16, level17, level18, level19, level20, level21, level22, level23};
@@ -0,0 +1,8 @@
+#ifndef LEVELS_H
+#define LEVELS_H
+#include <stdint.h>
+#include <gbdk/platform.h>
+BANKREF_EXTERN(levels)
+#define LEVEL_COUNT 24
+extern const uint8_t* const levels[LEVEL_COUNT];
+#endif
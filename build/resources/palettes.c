@@ -0,0 +1,5 @@
+#include <stdint.h>
+const uint8_t fadeBkgPalettes[13] = {0xFF, 0xFF, 0xFF, 0xFE, 0xFA, 0xFA, 0xFA, 0xE9, 0xE9, 0xE9, 0xE5, 0xE4, 0xE4};
+const uint8_t fadeSpritePalettes[13] = {0xFF, 0xFF, 0xFF, 0xBF, 0xBB, 0xBB, 0xBB, 0x6B, 0x6B, 0x6B, 0x67, 0x27, 0x27};
+const uint8_t flashBkgPalettes[4] = {0xBB, 0xB1, 0xFB, 0x44};
+const uint8_t flashSpritePalettes[4] = {0xBB, 0x23, 0x7B, 0x07};
@@ -0,0 +1,11 @@
+#ifndef PALETTES_H
+#define PALETTES_H
+#include <stdint.h>
+#define FADE_STEP_COUNT 13
+#define FLASH_PALETTE_COUNT 4
+#define HUD_BKG_PALETTE 0x1B
+extern const uint8_t fadeBkgPalettes[13];
+extern const uint8_t fadeSpritePalettes[13];
+extern const uint8_t flashBkgPalettes[4];
+extern const uint8_t flashSpritePalettes[4];
+#endif
@@ -0,0 +1,6 @@
+#include <stdint.h>
+#include <gbdk/platform.h>
+#include <gbdk/metasprites.h>
+BANKREF(sets)
+const uint8_t sets_tiles[1840] = {255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,0,255,126,129,126,129,126,129,126,129,126,129,126,129,0,255,255,255,159,129,191,189,191,189,255,189,255,189,255,129,255,255,0,255,24,153,60,189,110,231,126,231,60,189,24,153,0,255,255,255,240,240,199,192,223,192,152,135,176,143,177,143,178,143,255,255,15,15,227,3,251,3,25,225,13,241,141,241,77,241,77,241,141,241,13,241,25,225,251,3,227,3,15,15,255,255,178,143,177,143,176,143,152,135,223,192,199,192,240,240,255,255,255,255,0,0,255,0,255,0,0,255,0,255,255,255,0,255,77,241,77,241,77,241,77,241,77,241,77,241,77,241,77,241,0,255,255,255,0,255,0,255,255,0,255,0,0,0,255,255,178,143,178,143,178,143,178,143,178,143,178,143,178,143,178,143,255,255,195,195,189,189,189,189,129,129,189,189,189,189,255,255,255,255,131,131,189,189,131,131,189,189,189,189,131,131,255,255,255,255,195,195,189,189,191,191,191,191,189,189,195,195,255,255,255,255,135,135,187,187,189,189,189,189,187,187,135,135,255,255,255,255,129,129,191,191,131,131,191,191,191,191,129,129,255,255,255,255,129,129,191,191,131,131,191,191,191,191,191,191,255,255,255,255,195,195,189,189,191,191,177,177,189,189,195,195,255,255,255,255,189,189,189,189,129,129,189,189,189,189,189,189,255,255,255,255,227,227,247,247,247,247,247,247,247,247,227,227,255,255,255,255,241,241,251,251,251,251,187,187,187,187,199,199,255,255,255,255,187,187,183,183,143,143,183,183,187,187,189,189,255,255,255,255,191,191,191,191,191,191,191,191,191,191,129,129,255,255,255,255,189,189,153,153,165,165,189,189,189,189,189,189,255,255,255,255,189,189,157,157,173,173,181,181,185,185,189,189,255,255,255,255,195,195,189,189,189,189,189,189,189,189,195,195,255,255,255,255,131,131,189,189,189,189,131,131,191,191,191,191,255,255,255,255,195,195,189,189,189,189,181,181,185,185,195,195,255,255,255,255,131,131,189,189,189,189,131,131,187,187,189,189,255,255,255,255,193,193,191,191,195,195,253,253,253,253,131,131,255,255,255,255,131,131,239,239,239,239,239,239,239,239,239,239,255,255,255,255,189,189,189,189,189,189,189,189,189,189,195,195,255,255,255,255,189,189,189,189,189,189,189,189,219,219,231,231,255,255,255,255,189,189,189,189,189,189,189,189,165,165,219,219,255,255,255,255,189,189,219,219,231,231,231,231,219,219,189,189,255,255,255,255,187,187,215,215,239,239,239,239,239,239,239,239,255,255,255,255,129,129,251,251,247,247,239,239,223,223,129,129,255,255,255,255,255,255,195,195,253,253,193,193,189,189,193,193,255,255,255,255,191,191,191,191,131,131,189,189,189,189,131,131,255,255,255,255,255,255,227,227,223,223,223,223,223,223,227,227,255,255,255,255,251,251,251,251,131,131,123,123,123,123,131,131,255,255,255,255,255,255,195,195,189,189,129,129,191,191,193,193,255,255,255,255,243,243,239,239,231,231,239,239,239,239,239,239,255,255,255,255,255,255,193,193,189,189,193,193,253,253,195,195,255,255,255,255,191,191,191,191,131,131,189,189,189,189,189,189,255,255,255,255,247,247,255,255,231,231,247,247,247,247,227,227,255,255,255,255,247,247,255,255,247,247,247,247,215,215,239,239,255,255,255,255,223,223,219,219,215,215,207,207,215,215,219,219,255,255,255,255,223,223,223,223,223,223,223,223,223,223,231,231,255,255,255,255,255,255,195,195,213,213,213,213,213,213,213,213,255,255,255,255,255,255,135,135,187,187,187,187,187,187,187,187,255,255,255,255,255,255,195,195,189,189,189,189,189,189,195,195,255,255,255,255,255,255,131,131,189,189,189,189,131,131,191,191,255,255,255,255,255,255,193,193,189,189,189,189,193,193,253,253,255,255,255,255,255,255,161,161,159,159,191,191,191,191,191,191,255,255,255,255,255,255,195,195,191,191,195,195,253,253,131,131,255,255,255,255,239,239,199,199,239,239,239,239,239,239,243,243,255,255,255,255,255,255,189,189,189,189,189,189,189,189,195,195,255,255,255,255,255,255,189,189,189,189,189,189,219,219,231,231,255,255,255,255,255,255,189,189,189,189,189,189,165,165,219,219,255,255,255,255,255,255,221,221,235,235,247,247,235,235,221,221,255,255,255,255,255,255,189,189,189,189,193,193,253,253,195,195,255,255,255,255,255,255,193,193,251,251,247,247,239,239,193,193,255,255,255,255,195,195,185,185,181,181,173,173,157,157,195,195,255,255,255,255,247,247,231,231,215,215,247,247,247,247,193,193,255,255,255,255,195,195,189,189,253,253,195,195,191,191,129,129,255,255,255,255,195,195,189,189,243,243,253,253,189,189,195,195,255,255,255,255,251,251,243,243,235,235,219,219,129,129,251,251,255,255,255,255,129,129,191,191,131,131,253,253,189,189,195,195,255,255,255,255,195,195,191,191,131,131,189,189,189,189,195,195,255,255,255,255,129,129,253,253,251,251,247,247,239,239,239,239,255,255,255,255,195,195,189,189,195,195,189,189,189,189,195,195,255,255,255,255,195,195,189,189,189,189,193,193,253,253,195,195,255,255,255,255,195,195,189,189,165,165,161,161,191,191,195,195,255,255,255,255,247,247,247,247,247,247,247,247,255,255,247,247,255,255,255,255,227,227,221,221,251,251,247,247,255,255,247,247,255,255,255,255,235,235,235,235,255,255,255,255,255,255,255,255,255,255,255,255,219,219,129,129,219,219,219,219,129,129,219,219,255,255,255,255,239,239,195,195,239,239,199,199,235,235,135,135,255,255,255,255,225,225,223,223,131,131,135,135,223,223,225,225,255,255,255,255,227,227,221,221,223,223,135,135,223,223,129,129,255,255,255,255,157,157,155,155,247,247,239,239,217,217,185,185,255,255,255,255,207,207,183,183,207,207,181,181,187,187,197,197,255,255,255,255,247,247,239,239,239,239,239,239,239,239,247,247,255,255,255,255,239,239,247,247,247,247,247,247,247,247,239,239,255,255,255,255,255,255,235,235,247,247,193,193,247,247,235,235,255,255,255,255,255,255,255,255,255,255,195,195,255,255,255,255,255,255,255,255,255,255,247,247,247,247,193,193,247,247,247,247,255,255,255,255,255,255,255,255,255,255,255,255,231,231,231,231,255,255,255,255,255,255,255,255,255,255,239,239,239,239,223,223,255,255,255,255,253,253,251,251,247,247,239,239,223,223,191,191,255,255,255,255,191,191,223,223,239,239,247,247,251,251,253,253,255,255,255,255,255,255,247,247,239,239,223,223,239,239,247,247,255,255,255,255,255,255,239,239,247,247,251,251,247,247,239,239,255,255,255,255,255,255,255,255,195,195,255,255,195,195,255,255,255,255,255,255,195,195,189,189,165,165,173,173,165,165,195,195,255,255,255,255,231,231,239,239,239,239,239,239,239,239,231,231,255,255,255,255,231,231,247,247,247,247,247,247,247,247,231,231,255,255,255,255,247,247,247,247,247,247,247,247,247,247,247,247,255,255,255,255,255,255,255,255,255,255,129,129,255,255,255,255,255,255,255,255,255,255,255,255,251,251,231,231,223,223,255,255,255,255,255,255,247,247,235,235,221,221,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,221,221,235,235,247,247,255,255,255,255,247,247,255,255,255,255,247,247,255,255,255,255,255,255,255,255,247,247,255,255,247,247,247,247,239,239,255,255,255,255,255,255,187,187,215,215,239,239,239,239,215,215,187,187,255,255,255,255,1,1,239,239,239,239,239,239,239,239,239,239,255,255,255,255,190,190,221,221,235,235,247,247,247,247,247,247,255,255,255,255,227,227,221,221,135,135,223,223,135,135,221,221,227,227,255,255,239,239,195,195,175,175,199,199,235,235,135,135,239,239,255,255,195,195,189,189,165,165,173,173,165,165,189,189,195,195,255,255,255,255,223,223,255,255,255,255,223,223,255,255,255,255,255,255,7,7,123,123,123,123,7,7,119,119,123,123,255,255,255,255,255,255,135,135,171,171,171,171,171,171,171,171,255,255};
+const unsigned char sets_map[1200] = {0,1,2,3,4,5,6,7,8,9,10,11,1,1,1,1,1,1,1,1,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,57,58,59,60,61,62,63,64,65,66,67,68,69,70,71,72,73,74,75,76,77,78,79,80,81,82,83,84,85,86,87,88,89,90,91,92,93,94,95,96,97,98,99,100,101,102,103,104,105,106,107,108,109,110,111,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,30,25,12,22,16,0,0,0,18,12,24,16,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,5,0,0,11,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,9,0,0,11,1,1,1,1,2,2,2,1,1,3,1,1,1,1,1,1,9,0,0,11,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,9,0,0,7,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,53,55,42,56,56,0,0,30,31,12,29,31,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,5,11,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,9,11,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,9,11,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,9,11,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,9,11,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,9,11,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,9,11,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,9,11,1,2,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,9,11,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,9,11,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,9,11,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,9,11,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,9,11,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,9,11,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,9,11,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,9,7,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,30,14,26,29,16,112,64,64,64,0,23,16,33,16,23,112,64,64,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,18,12,24,16,0,0,26,33,16,113,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,39,62,0,0,55,47,52,58,55,42,57,63,89,40,52,114,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
@@ -0,0 +1,12 @@
+#ifndef METASPRITE_sets_H
+#define METASPRITE_sets_H
+#include <stdint.h>
+#include <gbdk/platform.h>
+#include <gbdk/metasprites.h>
+#define sets_TILE_COUNT 115
+#define sets_WIDTH 160
+#define sets_HEIGHT 480
+BANKREF_EXTERN(sets)
+extern const uint8_t sets_tiles[1840];
+extern const unsigned char sets_map[1200];
+#endif
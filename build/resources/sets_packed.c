@@ -0,0 +1,15 @@
+#include <stdint.h>
+#include <gbdk/platform.h>
+BANKREF(sets_packed)
+const uint8_t sets_menu_tileset[38] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 15, 16, 18, 22, 24, 25, 26, 29, 30, 31, 42, 53, 55, 56, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73};
+const uint8_t sets_board_tileset[46] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 14, 16, 18, 23, 24, 26, 29, 30, 33, 39, 40, 42, 47, 52, 55, 57, 58, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 89, 112, 113, 114};
+/* 608 bytes unpacked */
+const uint8_t sets_menu_tiles_packed[390] = {0x50, 0xFF, 0x0F, 0x00, 0xFF, 0x7E, 0x81, 0x7E, 0x81, 0x7E, 0x81, 0x7E, 0x81, 0x7E, 0x81, 0x7E, 0x81, 0x00, 0x43, 0xFF, 0x1D, 0x9F, 0x81, 0xBF, 0xBD, 0xBF, 0xBD, 0xFF, 0xBD, 0xFF, 0xBD, 0xFF, 0x81, 0xFF, 0xFF, 0x00, 0xFF, 0x18, 0x99, 0x3C, 0xBD, 0x6E, 0xE7, 0x7E, 0xE7, 0x3C, 0xBD, 0x18, 0x99, 0x00, 0x43, 0xFF, 0x0E, 0xF0, 0xF0, 0xC7, 0xC0, 0xDF, 0xC0, 0x98, 0x87, 0xB0, 0x8F, 0xB1, 0x8F, 0xB2, 0x8F, 0x82, 0xFF, 0x0F, 0x18, 0xE3, 0x03, 0xFB, 0x03, 0x19, 0xE1, 0x0D, 0xF1, 0x8D, 0xF1, 0x4D, 0xF1, 0x4D, 0xF1, 0x8D, 0xF1, 0x0D, 0xF1, 0x19, 0xE1, 0xFB, 0x03, 0xE3, 0x03, 0x82, 0x0F, 0xFF, 0x0C, 0xB2, 0x8F, 0xB1, 0x8F, 0xB0, 0x8F, 0x98, 0x87, 0xDF, 0xC0, 0xC7, 0xC0, 0x84, 0xF0, 0xFF, 0xFF, 0x00, 0x07, 0xFF, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x43, 0xFF, 0x13, 0x00, 0xFF, 0x4D, 0xF1, 0x4D, 0xF1, 0x4D, 0xF1, 0x4D, 0xF1, 0x4D, 0xF1, 0x4D, 0xF1, 0x4D, 0xF1, 0x4D, 0xF1, 0x00, 0x43, 0xFF, 0x07, 0x00, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0x43, 0x00, 0x12, 0xFF, 0xFF, 0xB2, 0x8F, 0xB2, 0x8F, 0xB2, 0x8F, 0xB2, 0x8F, 0xB2, 0x8F, 0xB2, 0x8F, 0xB2, 0x8F, 0xB2, 0x8F, 0xBF, 0xFF, 0xC3, 0xBD, 0xBD, 0x81, 0xBD, 0xBD, 0xFF, 0xFF, 0x83, 0xBD, 0x83, 0xBD, 0xBD, 0x83, 0xFF, 0xFF, 0x87, 0xBB, 0xBD, 0xBD, 0xBB, 0x87, 0xFF, 0xFF, 0x81, 0xBF, 0x83, 0xBF, 0xBF, 0x81, 0xFF, 0xFF, 0xC3, 0xBD, 0xBF, 0xB1, 0xBD, 0xC3, 0xFF, 0xFF, 0xBB, 0xB7, 0x8F, 0xB7, 0xBB, 0xBD, 0xFF, 0xFF, 0xBD, 0x99, 0xA5, 0xBD, 0xBD, 0xBD, 0xFF, 0xFF, 0xBD, 0x9D, 0xAD, 0xB5, 0xB9, 0xBD, 0xBF, 0xFF, 0xFF, 0xC3, 0xBD, 0xBD, 0xBD, 0xBD, 0xC3, 0xFF, 0xFF, 0x83, 0xBD, 0xBD, 0x83, 0xBB, 0xBD, 0xFF, 0xFF, 0xC1, 0xBF, 0xC3, 0xFD, 0xFD, 0x83, 0xFF, 0xFF, 0x83, 0xEF, 0xEF, 0xEF, 0xEF, 0xEF, 0xFF, 0xFF, 0xFF, 0xC3, 0xBD, 0x81, 0xBF, 0xC1, 0xFF, 0xFF, 0xFF, 0x83, 0xBD, 0xBD, 0x83, 0xBF, 0xFF, 0xFF, 0xFF, 0xA1, 0x9F, 0xBF, 0xBF, 0xBF, 0xFF, 0xFF, 0xFF, 0xC3, 0xBF, 0xC3, 0xFD, 0xBF, 0x83, 0xFF, 0xFF, 0xC3, 0xB9, 0xB5, 0xAD, 0x9D, 0xC3, 0xFF, 0xFF, 0xF7, 0xE7, 0xD7, 0xF7, 0xF7, 0xC1, 0xFF, 0xFF, 0xC3, 0xBD, 0xFD, 0xC3, 0xBF, 0x81, 0xFF, 0xFF, 0xC3, 0xBD, 0xF3, 0xFD, 0xBD, 0xC3, 0xFF, 0xFF, 0xFB, 0xF3, 0xEB, 0xDB, 0x81, 0xFB, 0xFF, 0xFF, 0x81, 0xBF, 0x83, 0xFD, 0xBD, 0xC3, 0xFF, 0xFF, 0xC3, 0xBF, 0x83, 0xBD, 0xBD, 0xC3, 0xFF, 0xFF, 0x81, 0xFD, 0xFB, 0xF7, 0x93, 0xEF, 0xEF, 0xFF, 0xFF, 0xC3, 0xBD, 0xC3, 0xBD, 0xBD, 0xC3, 0xFF, 0xFF, 0xC3, 0xBD, 0xBD, 0xC1, 0xFD, 0xC3, 0xFF, 0x00};
+/* 736 bytes unpacked */
+const uint8_t sets_board_tiles_packed[455] = {0x50, 0xFF, 0x0F, 0x00, 0xFF, 0x7E, 0x81, 0x7E, 0x81, 0x7E, 0x81, 0x7E, 0x81, 0x7E, 0x81, 0x7E, 0x81, 0x00, 0x43, 0xFF, 0x1D, 0x9F, 0x81, 0xBF, 0xBD, 0xBF, 0xBD, 0xFF, 0xBD, 0xFF, 0xBD, 0xFF, 0x81, 0xFF, 0xFF, 0x00, 0xFF, 0x18, 0x99, 0x3C, 0xBD, 0x6E, 0xE7, 0x7E, 0xE7, 0x3C, 0xBD, 0x18, 0x99, 0x00, 0x43, 0xFF, 0x0E, 0xF0, 0xF0, 0xC7, 0xC0, 0xDF, 0xC0, 0x98, 0x87, 0xB0, 0x8F, 0xB1, 0x8F, 0xB2, 0x8F, 0x82, 0xFF, 0x0F, 0x18, 0xE3, 0x03, 0xFB, 0x03, 0x19, 0xE1, 0x0D, 0xF1, 0x8D, 0xF1, 0x4D, 0xF1, 0x4D, 0xF1, 0x8D, 0xF1, 0x0D, 0xF1, 0x19, 0xE1, 0xFB, 0x03, 0xE3, 0x03, 0x82, 0x0F, 0xFF, 0x0C, 0xB2, 0x8F, 0xB1, 0x8F, 0xB0, 0x8F, 0x98, 0x87, 0xDF, 0xC0, 0xC7, 0xC0, 0x84, 0xF0, 0xFF, 0xFF, 0x00, 0x07, 0xFF, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x43, 0xFF, 0x13, 0x00, 0xFF, 0x4D, 0xF1, 0x4D, 0xF1, 0x4D, 0xF1, 0x4D, 0xF1, 0x4D, 0xF1, 0x4D, 0xF1, 0x4D, 0xF1, 0x4D, 0xF1, 0x00, 0x43, 0xFF, 0x07, 0x00, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0x43, 0x00, 0x12, 0xFF, 0xFF, 0xB2, 0x8F, 0xB2, 0x8F, 0xB2, 0x8F, 0xB2, 0x8F, 0xB2, 0x8F, 0xB2, 0x8F, 0xB2, 0x8F, 0xB2, 0x8F, 0xBF, 0xFF, 0xC3, 0xBD, 0xBD, 0x81, 0xBD, 0xBD, 0xFF, 0xFF, 0xC3, 0xBD, 0xBF, 0xBF, 0xBD, 0xC3, 0xFF, 0xFF, 0x81, 0xBF, 0x83, 0xBF, 0xBF, 0x81, 0xFF, 0xFF, 0xC3, 0xBD, 0xBF, 0xB1, 0xBD, 0xC3, 0xFF, 0xFF, 0xBF, 0xBF, 0xBF, 0xBF, 0xBF, 0x81, 0xFF, 0xFF, 0xBD, 0x99, 0xA5, 0xBD, 0xBD, 0xBD, 0xFF, 0xFF, 0xC3, 0xBD, 0xBD, 0xBD, 0xBD, 0xC3, 0xFF, 0xFF, 0x83, 0xBD, 0xBD, 0x83, 0xBB, 0xBD, 0xBF, 0xFF, 0xFF, 0xC1, 0xBF, 0xC3, 0xFD, 0xFD, 0x83, 0xFF, 0xFF, 0xBD, 0xBD, 0xBD, 0xBD, 0xDB, 0xE7, 0xFF, 0xFF, 0xBF, 0xBF, 0x83, 0xBD, 0xBD, 0x83, 0xFF, 0xFF, 0xFF, 0xE3, 0xDF, 0xDF, 0xDF, 0xE3, 0xFF, 0xFF, 0xFF, 0xC3, 0xBD, 0x81, 0xBF, 0xC1, 0xFF, 0xFF, 0xF7, 0xFF, 0xF7, 0xF7, 0xD7, 0xEF, 0xFF, 0xFF, 0xFF, 0xC3, 0xBD, 0xBD, 0xBD, 0xC3, 0xFF, 0xFF, 0xFF, 0xA1, 0x9F, 0xBF, 0xBF, 0xBF, 0xBF, 0xFF, 0xFF, 0xEF, 0xC7, 0xEF, 0xEF, 0xEF, 0xF3, 0xFF, 0xFF, 0xFF, 0xBD, 0xBD, 0xBD, 0xBD, 0xC3, 0xFF, 0xFF, 0xFF, 0xBD, 0xBD, 0xC1, 0xFD, 0xC3, 0xFF, 0xFF, 0xFF, 0xC1, 0xFB, 0xF7, 0xEF, 0xC1, 0xFF, 0xFF, 0xC3, 0xB9, 0xB5, 0xAD, 0x9D, 0xC3, 0xFF, 0xFF, 0xF7, 0xE7, 0xD7, 0xF7, 0xF7, 0xC1, 0xFF, 0xFF, 0xC3, 0xBD, 0xFD, 0xC3, 0xBF, 0x81, 0xFF, 0xFF, 0xC3, 0xBD, 0xF3, 0xFD, 0xBF, 0xBD, 0xC3, 0xFF, 0xFF, 0xFB, 0xF3, 0xEB, 0xDB, 0x81, 0xFB, 0xFF, 0xFF, 0x81, 0xBF, 0x83, 0xFD, 0xBD, 0xC3, 0xFF, 0xFF, 0xC3, 0xBF, 0x83, 0xBD, 0xBD, 0xC3, 0xFF, 0xFF, 0x81, 0xFD, 0xFB, 0xF7, 0xEF, 0xEF, 0xFF, 0xFF, 0xC3, 0xBD, 0xC3, 0xBD, 0xBD, 0xC3, 0xFF, 0xFF, 0xC3, 0xBD, 0xBD, 0xC1, 0xFD, 0xC3, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE7, 0xE7, 0xFF, 0xFF, 0xFF, 0xDF, 0xFF, 0x94, 0xFF, 0xDF, 0xFF, 0xFF, 0xFF, 0x07, 0x7B, 0x7B, 0x07, 0x77, 0x7B, 0xFF, 0xFF, 0xFF, 0x87, 0xAB, 0xAB, 0xAB, 0xAB, 0xFF, 0x00};
+/* 360 bytes unpacked */
+const uint8_t sets_menu_map_packed[172] = {0xA0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x1E, 0x19, 0x0C, 0x16, 0x10, 0x43, 0x00, 0x04, 0x12, 0x0C, 0x18, 0x10, 0x6D, 0x00, 0x01, 0x04, 0x50, 0x08, 0x04, 0x05, 0x00, 0x00, 0x0B, 0x50, 0x01, 0x04, 0x09, 0x00, 0x00, 0x0B, 0x83, 0x01, 0x01, 0x02, 0x04, 0x02, 0x01, 0x01, 0x03, 0x46, 0x01, 0x04, 0x09, 0x00, 0x00, 0x0B, 0x50, 0x01, 0x04, 0x09, 0x00, 0x00, 0x07, 0x50, 0x0A, 0x01, 0x06, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x35, 0x37, 0x2A, 0x82, 0x38, 0x00, 0x05, 0x1E, 0x1F, 0x0C, 0x1D, 0x1F, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+/* 20 bytes unpacked */
+const uint8_t sets_start_text_map_packed[18] = {0x44, 0x00, 0x03, 0x35, 0x37, 0x2A, 0x82, 0x38, 0x00, 0x05, 0x1E, 0x1F, 0x0C, 0x1D, 0x1F, 0x44, 0x00, 0x00};
+/* 360 bytes unpacked */
+const uint8_t sets_game_over_map_packed[180] = {0x07, 0x00, 0x1E, 0x0E, 0x1A, 0x1D, 0x10, 0x70, 0x43, 0x40, 0x07, 0x00, 0x17, 0x10, 0x21, 0x10, 0x17, 0x70, 0xBF, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x56, 0x00, 0x0A, 0x12, 0x0C, 0x18, 0x10, 0x00, 0x00, 0x1A, 0x21, 0x10, 0x71, 0xBF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x00, 0x27, 0x3E, 0x00, 0x00, 0x37, 0x2F, 0x34, 0x3A, 0x37, 0x2A, 0x39, 0x3F, 0x59, 0x28, 0x34, 0x72, 0x6A, 0x00, 0x00};
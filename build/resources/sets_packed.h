@@ -0,0 +1,23 @@
+#ifndef SETS_PACKED_H
+#define SETS_PACKED_H
+#include <stdint.h>
+#include <gbdk/platform.h>
+BANKREF_EXTERN(sets_packed)
+#define sets_TILE_COUNT 115
+#define sets_MAP_WIDTH 20
+#define sets_menu_MAP_ROW 6
+#define sets_menu_MAP_HEIGHT 18
+#define sets_start_text_MAP_ROW 20
+#define sets_start_text_MAP_HEIGHT 1
+#define sets_game_over_MAP_ROW 42
+#define sets_game_over_MAP_HEIGHT 18
+#define sets_menu_TILESET_SIZE 38
+extern const uint8_t sets_menu_tileset[38];
+#define sets_board_TILESET_SIZE 46
+extern const uint8_t sets_board_tileset[46];
+extern const uint8_t sets_menu_tiles_packed[390];
+extern const uint8_t sets_board_tiles_packed[455];
+extern const uint8_t sets_menu_map_packed[172];
+extern const uint8_t sets_start_text_map_packed[18];
+extern const uint8_t sets_game_over_map_packed[180];
+#endif
@@ -0,0 +1,6 @@
+#include <stdint.h>
+#include <gbdk/platform.h>
+#include <gbdk/metasprites.h>
+BANKREF(snake)
+const uint8_t snake_tiles[640] = {255,255,255,255,255,252,255,249,255,248,255,249,255,248,255,248,255,255,255,255,255,63,255,31,255,31,255,255,255,255,255,127,255,255,255,255,255,255,255,252,255,249,255,248,255,249,255,249,255,255,255,255,255,255,255,63,255,31,255,31,255,255,255,255,255,255,255,255,255,255,255,255,255,254,255,252,255,248,255,248,255,255,255,255,255,255,255,255,255,31,255,143,255,15,255,255,255,255,255,255,255,255,255,255,255,254,255,252,255,248,255,248,255,255,255,255,255,255,255,255,255,31,255,143,231,7,255,255,255,255,255,255,255,255,255,255,255,254,255,252,255,248,255,248,255,255,255,255,255,255,255,255,255,31,255,143,239,15,247,247,255,255,255,255,255,255,255,255,255,254,255,252,255,248,255,248,255,255,255,255,255,255,255,255,255,31,255,143,231,7,255,255,255,255,255,255,255,255,255,255,255,254,255,252,255,248,255,248,255,255,255,255,255,255,255,255,255,31,255,143,255,15,255,255,255,255,255,255,255,255,255,252,255,249,255,248,255,249,255,249,255,255,255,255,255,255,255,63,255,31,255,31,255,255,255,255,255,255,255,255,255,252,255,248,255,248,255,249,255,248,255,248,255,255,255,255,255,63,255,31,255,31,255,255,255,255,255,127,255,255,255,255,255,252,255,249,255,248,255,249,255,248,255,248,255,255,255,255,255,63,255,31,255,31,255,255,255,255,255,127,255,252,255,254,255,223,255,206,255,192,255,224,255,255,255,255,255,63,255,31,255,15,255,15,255,15,255,31,255,255,255,255,255,248,255,248,255,220,255,206,255,192,255,224,255,255,255,255,255,127,255,31,255,15,255,15,255,15,255,31,255,255,255,255,255,248,255,248,255,236,255,206,255,192,255,224,255,255,255,255,255,127,255,31,255,15,255,15,255,15,255,31,255,255,255,255,255,248,255,248,255,220,255,206,255,192,255,224,255,255,255,255,255,127,255,31,255,15,255,15,255,15,255,31,255,255,255,255,255,248,255,248,255,236,255,206,255,192,255,224,255,255,255,255,255,127,255,31,255,15,255,15,255,15,255,31,255,255,255,255,255,248,255,248,255,220,255,206,255,192,255,224,255,255,255,255,255,127,255,31,255,15,255,15,255,15,255,31,255,255,255,255,255,248,255,248,255,236,255,206,255,192,255,224,255,255,255,255,255,127,255,31,255,15,255,15,255,15,255,31,255,255,255,255,255,248,255,248,255,220,255,206,255,192,255,224,255,255,255,255,255,127,255,31,255,15,255,15,255,15,255,31,255,255,255,255,255,252,255,254,255,223,255,206,255,192,255,224,255,255,255,255,255,63,255,31,255,15,255,15,255,15,255,31,255,255,255,255,255,252,255,254,255,223,255,206,255,192,255,224,255,255,255,255,255,63,255,31,255,15,255,15,255,15,255,31,255,255,255,255};
+const unsigned char snake_map[40] = {0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31,32,33,34,35,36,37,38,39};
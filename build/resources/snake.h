@@ -0,0 +1,12 @@
+#ifndef METASPRITE_snake_H
+#define METASPRITE_snake_H
+#include <stdint.h>
+#include <gbdk/platform.h>
+#include <gbdk/metasprites.h>
+#define snake_TILE_COUNT 40
+#define snake_WIDTH 160
+#define snake_HEIGHT 16
+BANKREF_EXTERN(snake)
+extern const uint8_t snake_tiles[640];
+extern const unsigned char snake_map[40];
+#endif
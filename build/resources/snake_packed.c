@@ -0,0 +1,5 @@
+#include <stdint.h>
+#include <gbdk/platform.h>
+BANKREF(snake_packed)
+/* 640 bytes unpacked */
+const uint8_t snake_tiles_packed[494] = {0x45, 0xFF, 0x0B, 0xFC, 0xFF, 0xF9, 0xFF, 0xF8, 0xFF, 0xF9, 0xFF, 0xF8, 0xFF, 0xF8, 0x45, 0xFF, 0x05, 0x3F, 0xFF, 0x1F, 0xFF, 0x1F, 0x45, 0xFF, 0x01, 0x7F, 0x47, 0xFF, 0x09, 0xFC, 0xFF, 0xF9, 0xFF, 0xF8, 0xFF, 0xF9, 0xFF, 0xF9, 0x47, 0xFF, 0x05, 0x3F, 0xFF, 0x1F, 0xFF, 0x1F, 0x4D, 0xFF, 0x07, 0xFE, 0xFF, 0xFC, 0xFF, 0xF8, 0xFF, 0xF8, 0x49, 0xFF, 0x05, 0x1F, 0xFF, 0x8F, 0xFF, 0x0F, 0x4B, 0xFF, 0x07, 0xFE, 0xFF, 0xFC, 0xFF, 0xF8, 0xFF, 0xF8, 0x49, 0xFF, 0x05, 0x1F, 0xFF, 0x8F, 0xE7, 0x07, 0x4B, 0xFF, 0x07, 0xFE, 0xFF, 0xFC, 0xFF, 0xF8, 0xFF, 0xF8, 0x49, 0xFF, 0x05, 0x1F, 0xFF, 0x8F, 0xEF, 0x0F, 0x85, 0xF7, 0xFF, 0xFF, 0xFF, 0xFF, 0x08, 0xFF, 0xFE, 0xFF, 0xFC, 0xFF, 0xF8, 0xFF, 0xF8, 0x49, 0xFF, 0x05, 0x1F, 0xFF, 0x8F, 0xE7, 0x07, 0x4B, 0xFF, 0x07, 0xFE, 0xFF, 0xFC, 0xFF, 0xF8, 0xFF, 0xF8, 0x49, 0xFF, 0x05, 0x1F, 0xFF, 0x8F, 0xFF, 0x0F, 0x49, 0xFF, 0x09, 0xFC, 0xFF, 0xF9, 0xFF, 0xF8, 0xFF, 0xF9, 0xFF, 0xF9, 0x47, 0xFF, 0x05, 0x3F, 0xFF, 0x1F, 0xFF, 0x1F, 0x49, 0xFF, 0x0B, 0xFC, 0xFF, 0xF8, 0xFF, 0xF8, 0xFF, 0xF9, 0xFF, 0xF8, 0xFF, 0xF8, 0x45, 0xFF, 0x05, 0x3F, 0xFF, 0x1F, 0xFF, 0x1F, 0x45, 0xFF, 0x01, 0x7F, 0x45, 0xFF, 0x0B, 0xFC, 0xFF, 0xF9, 0xFF, 0xF8, 0xFF, 0xF9, 0xFF, 0xF8, 0xFF, 0xF8, 0x45, 0xFF, 0x05, 0x3F, 0xFF, 0x1F, 0xFF, 0x1F, 0x45, 0xFF, 0x0D, 0x7F, 0xFF, 0xFC, 0xFF, 0xFE, 0xFF, 0xDF, 0xFF, 0xCE, 0xFF, 0xC0, 0xFF, 0xE0, 0x45, 0xFF, 0x0B, 0x3F, 0xFF, 0x1F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x1F, 0x45, 0xFF, 0x0B, 0xF8, 0xFF, 0xF8, 0xFF, 0xDC, 0xFF, 0xCE, 0xFF, 0xC0, 0xFF, 0xE0, 0x45, 0xFF, 0x0B, 0x7F, 0xFF, 0x1F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x1F, 0x45, 0xFF, 0x0B, 0xF8, 0xFF, 0xF8, 0xFF, 0xEC, 0xFF, 0xCE, 0xFF, 0xC0, 0xFF, 0xE0, 0x45, 0xFF, 0x0B, 0x7F, 0xFF, 0x1F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x1F, 0x45, 0xFF, 0x0B, 0xF8, 0xFF, 0xF8, 0xFF, 0xDC, 0xFF, 0xCE, 0xFF, 0xC0, 0xFF, 0xE0, 0x45, 0xFF, 0x0B, 0x7F, 0xFF, 0x1F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x1F, 0x45, 0xFF, 0x0B, 0xF8, 0xFF, 0xF8, 0xFF, 0xEC, 0xFF, 0xCE, 0xFF, 0xC0, 0xFF, 0xE0, 0x45, 0xFF, 0x0B, 0x7F, 0xFF, 0x1F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x1F, 0x45, 0xFF, 0x0B, 0xF8, 0xFF, 0xF8, 0xFF, 0xDC, 0xFF, 0xCE, 0xFF, 0xC0, 0xFF, 0xE0, 0x45, 0xFF, 0x0B, 0x7F, 0xFF, 0x1F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x1F, 0x45, 0xFF, 0x0B, 0xF8, 0xFF, 0xF8, 0xFF, 0xEC, 0xFF, 0xCE, 0xFF, 0xC0, 0xFF, 0xE0, 0x45, 0xFF, 0x0B, 0x7F, 0xFF, 0x1F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x1F, 0x45, 0xFF, 0x0B, 0xF8, 0xFF, 0xF8, 0xFF, 0xDC, 0xFF, 0xCE, 0xFF, 0xC0, 0xFF, 0xE0, 0x45, 0xFF, 0x0B, 0x7F, 0xFF, 0x1F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x1F, 0x45, 0xFF, 0x0B, 0xFC, 0xFF, 0xFE, 0xFF, 0xDF, 0xFF, 0xCE, 0xFF, 0xC0, 0xFF, 0xE0, 0x45, 0xFF, 0x0B, 0x3F, 0xFF, 0x1F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x1F, 0x45, 0xFF, 0x0B, 0xFC, 0xFF, 0xFE, 0xFF, 0xDF, 0xFF, 0xCE, 0xFF, 0xC0, 0xFF, 0xE0, 0x45, 0xFF, 0x0B, 0x3F, 0xFF, 0x1F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x1F, 0x44, 0xFF, 0x00};
@@ -0,0 +1,9 @@
+#ifndef SNAKE_PACKED_H
+#define SNAKE_PACKED_H
+#include <stdint.h>
+#include <gbdk/platform.h>
+BANKREF_EXTERN(snake_packed)
+#define snake_TILE_COUNT 40
+#define snake_MAP_WIDTH 20
+extern const uint8_t snake_tiles_packed[494];
+#endif
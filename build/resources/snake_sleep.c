@@ -0,0 +1,6 @@
+#include <stdint.h>
+#include <gbdk/platform.h>
+#include <gbdk/metasprites.h>
+BANKREF(snake_sleep)
+const uint8_t snake_sleep_tiles[640] = {255,255,255,255,255,255,255,255,255,254,255,252,255,252,255,252,255,255,255,255,255,255,255,255,255,31,255,143,231,7,255,255,255,255,255,255,255,255,255,254,255,253,255,252,255,252,255,252,255,255,255,255,255,255,255,31,223,31,255,63,255,127,255,255,255,252,255,248,255,248,255,250,255,248,255,252,255,252,255,252,255,255,255,255,255,255,255,255,255,255,255,127,255,127,255,127,255,252,255,248,255,248,255,250,255,248,255,252,255,252,255,252,255,255,255,255,255,255,255,255,255,255,255,127,255,127,255,127,255,252,255,248,255,248,255,250,255,248,255,252,255,252,255,252,255,255,255,255,255,255,255,255,255,255,255,127,255,127,255,127,255,255,255,255,255,255,255,252,255,248,255,248,255,248,255,248,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,127,255,255,255,255,255,255,255,255,255,227,255,225,255,240,255,240,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,127,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,252,255,252,255,254,255,255,255,239,255,231,255,224,255,240,255,127,255,63,255,31,255,15,255,135,255,7,255,7,255,15,255,252,255,252,255,254,255,247,255,243,255,243,255,240,255,248,255,127,255,63,255,31,255,15,255,143,255,15,255,15,255,31,255,252,255,254,255,255,255,253,255,249,255,248,255,248,255,252,255,63,255,63,255,31,255,31,255,31,255,31,255,31,255,63,255,252,255,254,255,255,255,255,255,254,255,252,255,248,255,248,255,63,255,63,255,31,255,31,255,31,255,31,255,31,255,63,255,252,255,254,255,255,255,255,255,255,255,252,255,248,255,248,255,63,255,63,255,31,255,31,255,31,255,31,255,31,255,31,255,252,255,252,255,254,255,255,255,255,255,252,255,248,255,248,255,63,255,31,255,31,255,143,255,143,255,15,255,31,255,31,255,252,255,252,255,254,255,255,255,255,255,252,255,248,255,248,255,63,255,31,255,31,255,143,255,143,255,15,255,31,255,31,255,193,255,192,255,224,255,254,255,255,255,252,255,248,255,248,255,255,255,127,255,31,255,15,255,143,255,15,255,15,255,15,255,255,255,255,255,252,255,192,255,128,255,128,255,248,255,248,255,255,255,255,255,127,255,31,255,15,255,15,255,15,255,15,255,255,255,255,255,255,255,254,255,248,255,0,255,0,255,0,255,255,255,255,255,255,255,63,255,31,255,15,255,15,255,15};
+const unsigned char snake_sleep_map[40] = {0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31,32,33,34,35,36,37,38,39};
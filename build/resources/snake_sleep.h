@@ -0,0 +1,12 @@
+#ifndef METASPRITE_snake_sleep_H
+#define METASPRITE_snake_sleep_H
+#include <stdint.h>
+#include <gbdk/platform.h>
+#include <gbdk/metasprites.h>
+#define snake_sleep_TILE_COUNT 40
+#define snake_sleep_WIDTH 160
+#define snake_sleep_HEIGHT 16
+BANKREF_EXTERN(snake_sleep)
+extern const uint8_t snake_sleep_tiles[640];
+extern const unsigned char snake_sleep_map[40];
+#endif
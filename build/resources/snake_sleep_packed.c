@@ -0,0 +1,5 @@
+#include <stdint.h>
+#include <gbdk/platform.h>
+BANKREF(snake_sleep_packed)
+/* 640 bytes unpacked */
+const uint8_t snake_sleep_tiles_packed[493] = {0x49, 0xFF, 0x07, 0xFE, 0xFF, 0xFC, 0xFF, 0xFC, 0xFF, 0xFC, 0x49, 0xFF, 0x05, 0x1F, 0xFF, 0x8F, 0xE7, 0x07, 0x49, 0xFF, 0x09, 0xFE, 0xFF, 0xFD, 0xFF, 0xFC, 0xFF, 0xFC, 0xFF, 0xFC, 0x47, 0xFF, 0x07, 0x1F, 0xDF, 0x1F, 0xFF, 0x3F, 0xFF, 0x7F, 0x43, 0xFF, 0x0F, 0xFC, 0xFF, 0xF8, 0xFF, 0xF8, 0xFF, 0xFA, 0xFF, 0xF8, 0xFF, 0xFC, 0xFF, 0xFC, 0xFF, 0xFC, 0x4B, 0xFF, 0x15, 0x7F, 0xFF, 0x7F, 0xFF, 0x7F, 0xFF, 0xFC, 0xFF, 0xF8, 0xFF, 0xF8, 0xFF, 0xFA, 0xFF, 0xF8, 0xFF, 0xFC, 0xFF, 0xFC, 0xFF, 0xFC, 0x4B, 0xFF, 0x15, 0x7F, 0xFF, 0x7F, 0xFF, 0x7F, 0xFF, 0xFC, 0xFF, 0xF8, 0xFF, 0xF8, 0xFF, 0xFA, 0xFF, 0xF8, 0xFF, 0xFC, 0xFF, 0xFC, 0xFF, 0xFC, 0x4B, 0xFF, 0x05, 0x7F, 0xFF, 0x7F, 0xFF, 0x7F, 0x47, 0xFF, 0x09, 0xFC, 0xFF, 0xF8, 0xFF, 0xF8, 0xFF, 0xF8, 0xFF, 0xF8, 0x4F, 0xFF, 0x01, 0x7F, 0x49, 0xFF, 0x07, 0xE3, 0xFF, 0xE1, 0xFF, 0xF0, 0xFF, 0xF0, 0x4F, 0xFF, 0x01, 0x7F, 0xB0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x06, 0xFF, 0xFC, 0xFF, 0xFC, 0xFF, 0xFE, 0x43, 0xFF, 0x3B, 0xEF, 0xFF, 0xE7, 0xFF, 0xE0, 0xFF, 0xF0, 0xFF, 0x7F, 0xFF, 0x3F, 0xFF, 0x1F, 0xFF, 0x0F, 0xFF, 0x87, 0xFF, 0x07, 0xFF, 0x07, 0xFF, 0x0F, 0xFF, 0xFC, 0xFF, 0xFC, 0xFF, 0xFE, 0xFF, 0xF7, 0xFF, 0xF3, 0xFF, 0xF3, 0xFF, 0xF0, 0xFF, 0xF8, 0xFF, 0x7F, 0xFF, 0x3F, 0xFF, 0x1F, 0xFF, 0x0F, 0xFF, 0x8F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x1F, 0xFF, 0xFC, 0xFF, 0xFE, 0x43, 0xFF, 0x1D, 0xFD, 0xFF, 0xF9, 0xFF, 0xF8, 0xFF, 0xF8, 0xFF, 0xFC, 0xFF, 0x3F, 0xFF, 0x3F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFF, 0x3F, 0xFF, 0xFC, 0xFF, 0xFE, 0x45, 0xFF, 0x1B, 0xFE, 0xFF, 0xFC, 0xFF, 0xF8, 0xFF, 0xF8, 0xFF, 0x3F, 0xFF, 0x3F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFF, 0x3F, 0xFF, 0xFC, 0xFF, 0xFE, 0x47, 0xFF, 0x1B, 0xFC, 0xFF, 0xF8, 0xFF, 0xF8, 0xFF, 0x3F, 0xFF, 0x3F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFF, 0xFC, 0xFF, 0xFC, 0xFF, 0xFE, 0x45, 0xFF, 0x1B, 0xFC, 0xFF, 0xF8, 0xFF, 0xF8, 0xFF, 0x3F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFF, 0x8F, 0xFF, 0x8F, 0xFF, 0x0F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFF, 0xFC, 0xFF, 0xFC, 0xFF, 0xFE, 0x45, 0xFF, 0x1D, 0xFC, 0xFF, 0xF8, 0xFF, 0xF8, 0xFF, 0x3F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFF, 0x8F, 0xFF, 0x8F, 0xFF, 0x0F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFF, 0xC1, 0xFF, 0xC0, 0xFF, 0xE0, 0xFF, 0xFE, 0x43, 0xFF, 0x05, 0xFC, 0xFF, 0xF8, 0xFF, 0xF8, 0x43, 0xFF, 0x0D, 0x7F, 0xFF, 0x1F, 0xFF, 0x0F, 0xFF, 0x8F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x0F, 0x45, 0xFF, 0x0B, 0xFC, 0xFF, 0xC0, 0xFF, 0x80, 0xFF, 0x80, 0xFF, 0xF8, 0xFF, 0xF8, 0x45, 0xFF, 0x0B, 0x7F, 0xFF, 0x1F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x0F, 0x47, 0xFF, 0x09, 0xFE, 0xFF, 0xF8, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0x47, 0xFF, 0x09, 0x3F, 0xFF, 0x1F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x0F, 0x00};
@@ -0,0 +1,9 @@
+#ifndef SNAKE_SLEEP_PACKED_H
+#define SNAKE_SLEEP_PACKED_H
+#include <stdint.h>
+#include <gbdk/platform.h>
+BANKREF_EXTERN(snake_sleep_packed)
+#define snake_sleep_TILE_COUNT 40
+#define snake_sleep_MAP_WIDTH 20
+extern const uint8_t snake_sleep_tiles_packed[493];
+#endif
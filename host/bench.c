@@ -0,0 +1,517 @@
+/**
+ * @file bench.c
+ * @author Raphael Jouretz (rjouretz.com)
+ * @brief Measure the hot paths of the board (engine and screen updates) on
+ * the host, print them as JSON and compare them to a saved baseline
+ * @version 0.1
+ * @date 2023-06-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <resources/levels.h>
+#include <unistd.h>
+
+#include "autopilot.h"
+#include "engine.h"
+#include "graphics.h"
+
+/** the open level of the largest board size (see resources/levels.txt) */
+#define CYCLE_LEVEL 10
+
+/** the interior of the cycle level, walked by the snake along a cycle */
+#define INTERIOR_WIDTH  (BOARD_WIDTH - 2)
+#define INTERIOR_HEIGHT (BOARD_HEIGHT - 2)
+#define CYCLE_LENGTH    (INTERIOR_WIDTH * INTERIOR_HEIGHT)
+
+/** the minimum duration of a measure */
+#define MIN_MEASURE_NS 20000000.0
+
+/** the number of measures of a benchmark, the fastest one is kept */
+#define MEASURE_COUNT 5
+
+/** the maximum number of results */
+#define MAX_RESULTS 128
+
+/** the number of games played to count the allocations */
+#define ALLOCATION_GAMES 100
+
+/*************************************************
+**                 structures                   **
+*************************************************/
+
+/** @struct BenchResult
+ *  Represent the result of a benchmark.
+ *
+ *  @var BenchResult::name
+ *    The name of the measured operation.
+ *  @var BenchResult::length
+ *    The length of the snake during the measure.
+ *  @var BenchResult::fill
+ *    The ratio of the playable cells that are not empty (the snake and the
+ *    loots), 0 if the operation does not depend on the snake.
+ *  @var BenchResult::nsPerOp
+ *    The duration of an operation.
+ */
+typedef struct {
+    char name[32];
+    int length;
+    double fill;
+    double nsPerOp;
+} BenchResult;
+
+/*************************************************
+**               private variables              **
+*************************************************/
+
+/** the private functions of the engine (see engine.c) */
+void PushSnakeHead(Snake* snake, uint16_t pos);
+uint16_t PopSnakeTail(Snake* snake);
+void AddFreeCell(FreeCells* freeCells, uint16_t pos);
+void RemoveFreeCell(FreeCells* freeCells, uint16_t pos);
+uint8_t AddRandomLoot(EngineState* state);
+
+/** counted by the malloc wrapper (-Wl,--wrap=malloc) */
+unsigned long allocationCount;
+void* __real_malloc(size_t size);
+
+EngineState state;
+Autopilot autopilot;
+uint16_t cycle[CYCLE_LENGTH];
+uint16_t cycleHead;
+uint16_t cycleTail;
+
+BenchResult results[MAX_RESULTS];
+int resultCount;
+
+volatile uint32_t sink;
+
+/*************************************************
+**              private functions               **
+*************************************************/
+
+/**
+ * @brief Count the allocations
+ *
+ * @param size the size to allocate
+ * @return the allocated memory
+ */
+void* __wrap_malloc(size_t size)
+{
+    allocationCount++;
+    return __real_malloc(size);
+}
+
+/**
+ * @brief Get the current time in nanoseconds
+ *
+ * @return the current time
+ */
+double NowNs()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+/**
+ * @brief Build a cycle going through every interior cell of the board: the
+ * first row from left to right, then the other rows column by column.
+ *
+ */
+void BuildCycle()
+{
+    uint16_t i = 0;
+
+    for (uint8_t x = 0; x < INTERIOR_WIDTH; x++)
+        cycle[i++] = PACK_POSITION(x + 1, 1);
+
+    // INTERIOR_WIDTH is even, so the last column goes up next to the start
+    for (int8_t x = INTERIOR_WIDTH - 1; x >= 0; x--) {
+        BOOLEAN isDown = (INTERIOR_WIDTH - 1 - x) % 2 == 0;
+        for (uint8_t j = 1; j < INTERIOR_HEIGHT; j++) {
+            uint8_t y = isDown ? j : INTERIOR_HEIGHT - j;
+            cycle[i++] = PACK_POSITION(x + 1, y + 1);
+        }
+    }
+}
+
+/**
+ * @brief Get the input moving from a packed position to the next one
+ *
+ * @param from the packed position of the head
+ * @param to the next packed position
+ * @return the input to give to StepEngine
+ */
+uint8_t DirectionTo(uint16_t from, uint16_t to)
+{
+    if (to == from + 1) return INPUT_RIGHT;
+    if (to + 1 == from) return INPUT_LEFT;
+    if (to > from) return INPUT_DOWN;
+    return INPUT_UP;
+}
+
+/**
+ * @brief Reset the state with a snake of the given length laid along the
+ * cycle.
+ *
+ * @param length the length of the snake (1 to CYCLE_LENGTH - 2)
+ */
+void SetupSnake(uint16_t length)
+{
+    InitEngine(&state, levels[CYCLE_LEVEL], 1, NULL);
+
+    // the snake of the level is replaced by the snake of the cycle
+    uint16_t spawn = PopSnakeTail(&state.snake);
+    state.cells[spawn] = EMPTY_CELL;
+    AddFreeCell(&state.freeCells, spawn);
+
+    for (uint16_t i = 0; i < length; i++) {
+        PushSnakeHead(&state.snake, cycle[i]);
+        RemoveFreeCell(&state.freeCells, cycle[i]);
+        state.cells[cycle[i]] = SNAKE_CELL;
+    }
+
+    state.boardCellCount = CYCLE_LENGTH;
+    state.dir = DirectionTo(cycle[length - 1], cycle[length % CYCLE_LENGTH]);
+    cycleTail = 0;
+    cycleHead = length - 1;
+}
+
+/**
+ * @brief Move the snake one cell forward along the cycle
+ *
+ */
+void OpMove()
+{
+    uint16_t next = cycleHead + 1 == CYCLE_LENGTH ? 0 : cycleHead + 1;
+
+    state.moveProgress = 0x100 - state.speed;
+    state.lootTimer = 0xFFFF;
+    sink += StepEngine(&state, DirectionTo(cycle[cycleHead], cycle[next]));
+
+    cycleHead = next;
+    cycleTail = cycleTail + 1 == CYCLE_LENGTH ? 0 : cycleTail + 1;
+}
+
+/**
+ * @brief Eat a loot put in front of the snake, then remove the tail to keep
+ * the length of the snake.
+ *
+ */
+void OpGrow()
+{
+    uint16_t next = cycleHead + 1 == CYCLE_LENGTH ? 0 : cycleHead + 1;
+
+    RemoveFreeCell(&state.freeCells, cycle[next]);
+    state.cells[cycle[next]] = LOOT_CELL;
+
+    state.moveProgress = 0x100 - state.speed;
+    state.lootTimer = 0xFFFF;
+    sink += StepEngine(&state, DirectionTo(cycle[cycleHead], cycle[next]));
+
+    uint16_t tail = PopSnakeTail(&state.snake);
+    AddFreeCell(&state.freeCells, tail);
+    state.cells[tail] = EMPTY_CELL;
+
+    cycleHead = next;
+    cycleTail = cycleTail + 1 == CYCLE_LENGTH ? 0 : cycleTail + 1;
+}
+
+/**
+ * @brief Drop a loot on a random empty cell, then remove it.
+ *
+ */
+void OpLoot()
+{
+    sink += AddRandomLoot(&state);
+
+    AddFreeCell(&state.freeCells, state.lastLoot);
+    state.cells[state.lastLoot] = EMPTY_CELL;
+}
+
+/**
+ * @brief Choose the next move of the snake with the autopilot (a loot is
+ * dropped on a random empty cell before the measure)
+ *
+ */
+void OpAutopilot()
+{
+    state.moveProgress = 0x100 - state.speed;
+    sink += NextAutopilotInput(&autopilot, &state);
+}
+
+/**
+ * @brief Read the cell in front of the head of a pseudo random cell
+ *
+ */
+void OpCollision()
+{
+    static uint16_t i;
+    i = (i + 97) % CYCLE_LENGTH;
+    sink += state.cells[cycle[i] + 1];
+}
+
+/**
+ * @brief Run a tick without move nor loot drop
+ *
+ */
+void OpIdleTick()
+{
+    state.moveProgress = 0;
+    state.lootTimer = 0xFFFF;
+    sink += StepEngine(&state, 0);
+}
+
+/**
+ * @brief Draw a cell of the board
+ *
+ */
+void OpDrawCell()
+{
+    static uint16_t i;
+    i = i + 1 == CYCLE_LENGTH ? 0 : i + 1;
+    SetBoardCell(POSITION_X(cycle[i]), POSITION_Y(cycle[i]), SNAKE_CELL);
+}
+
+/**
+ * @brief Update the score of the legend
+ *
+ */
+void OpLegendScore()
+{
+    static uint16_t score;
+    score = score == 999 ? 0 : score + 1;
+    SetLegendScore(score);
+}
+
+/**
+ * @brief Update the level of the legend
+ *
+ */
+void OpLegendLevel()
+{
+    static uint8_t level;
+    SetLegendLevel(level++ % 100);
+}
+
+/**
+ * @brief Measure an operation and add the result
+ *
+ * @param name the name of the operation
+ * @param op the operation
+ * @param length the length of the snake (0 if not relevant)
+ */
+void Measure(const char* name, void (*op)(), int length)
+{
+    uint32_t iterations = 1;
+    double best = 0;
+
+    // find an iteration count lasting MIN_MEASURE_NS
+    while (1) {
+        double start = NowNs();
+        for (uint32_t i = 0; i < iterations; i++) op();
+        double duration = NowNs() - start;
+
+        if (duration >= MIN_MEASURE_NS || iterations >= (1U << 30)) {
+            best = duration / iterations;
+            break;
+        }
+        iterations *= 2;
+    }
+
+    for (int m = 1; m < MEASURE_COUNT; m++) {
+        double start = NowNs();
+        for (uint32_t i = 0; i < iterations; i++) op();
+        double nsPerOp = (NowNs() - start) / iterations;
+        if (nsPerOp < best) best = nsPerOp;
+    }
+
+    // a game over would turn the next operations into no-ops
+    if (state.isOver) {
+        fprintf(stderr, "%s: the game is over\n", name);
+        exit(1);
+    }
+
+    if (resultCount == MAX_RESULTS) return;
+
+    BenchResult* result = &results[resultCount++];
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    result->length = length;
+    // the snake and the loots, from the state the operation left
+    result->fill = length ? (double)(state.boardCellCount -
+                                     state.freeCells.count) /
+                                state.boardCellCount
+                          : 0;
+    result->nsPerOp = best;
+}
+
+/**
+ * @brief Count the allocations of ALLOCATION_GAMES games
+ *
+ * @return the number of allocations per game
+ */
+double CountAllocations()
+{
+    unsigned long count = allocationCount;
+
+    for (uint16_t seed = 1; seed <= ALLOCATION_GAMES; seed++) {
+        InitEngine(&state, levels[0], seed, NULL);
+        for (uint32_t tick = 0; !state.isOver; tick++)
+            StepEngine(&state, 1U << ((tick / 30 + seed) & 3));
+    }
+
+    return (double)(allocationCount - count) / ALLOCATION_GAMES;
+}
+
+/**
+ * @brief Print the results as JSON, one benchmark per line
+ *
+ * @param allocations the number of allocations per game
+ */
+void PrintResults(double allocations)
+{
+    printf("{\n  \"allocations_per_game\": %.2f,\n  \"benchmarks\": [\n",
+           allocations);
+
+    for (int i = 0; i < resultCount; i++) {
+        BenchResult* r = &results[i];
+        printf("    {\"name\": \"%s\", \"snake_length\": %d, \"fill\": %.3f, "
+               "\"ns_per_op\": %.3f, \"ops_per_second\": %.0f}%s\n",
+               r->name, r->length, r->fill, r->nsPerOp, 1e9 / r->nsPerOp,
+               i + 1 < resultCount ? "," : "");
+    }
+
+    printf("  ]\n}\n");
+}
+
+/**
+ * @brief Compare the results to a baseline printed by PrintResults
+ *
+ * @param path the path of the baseline
+ * @param threshold the slowdown (in percent) considered as a regression
+ * @return the number of regressions, -1 if the baseline cannot be read
+ */
+int CompareResults(const char* path, double threshold)
+{
+    FILE* file = fopen(path, "r");
+    if (!file) return -1;
+
+    char line[512];
+    int regressions = 0;
+
+    fprintf(stderr, "%-16s %6s %12s %12s %8s\n", "name", "length",
+            "baseline ns", "current ns", "change");
+
+    while (fgets(line, sizeof(line), file)) {
+        char name[32];
+        int length;
+        double fill, nsPerOp;
+
+        if (sscanf(line,
+                   " {\"name\": \"%31[^\"]\", \"snake_length\": %d, "
+                   "\"fill\": %lf, \"ns_per_op\": %lf",
+                   name, &length, &fill, &nsPerOp) != 4)
+            continue;
+
+        for (int i = 0; i < resultCount; i++) {
+            BenchResult* r = &results[i];
+            if (strcmp(r->name, name) != 0 || r->length != length) continue;
+
+            double change = (r->nsPerOp / nsPerOp - 1) * 100;
+            BOOLEAN isRegression = change > threshold;
+            if (isRegression) regressions++;
+
+            fprintf(stderr, "%-16s %6d %12.3f %12.3f %+7.1f%%%s\n", name,
+                    length, nsPerOp, r->nsPerOp, change,
+                    isRegression ? " REGRESSION" : "");
+        }
+    }
+
+    fclose(file);
+    return regressions;
+}
+
+/**
+ * @brief Print the command usage
+ *
+ * @param name the name of the command
+ */
+void PrintUsage(const char* name)
+{
+    fprintf(stderr,
+            "usage: %s [-b baseline.json] [-t percent]\n"
+            "  -b baseline  compare to a saved output of this command\n"
+            "  -t percent   slowdown reported as a regression (default 10)\n",
+            name);
+}
+
+/*************************************************
+**               public functions               **
+*************************************************/
+
+int main(int argc, char** argv)
+{
+    const char* baselinePath = NULL;
+    double threshold = 10;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:t:")) != -1) {
+        switch (opt) {
+            case 'b': baselinePath = optarg; break;
+            case 't': threshold = strtod(optarg, NULL); break;
+            default: PrintUsage(argv[0]); return 1;
+        }
+    }
+
+    // the drawing functions queue the tiles, the queue is flushed by the
+    // VBlank handler each time it is full
+    set_interrupts(VBL_IFLAG);
+    enable_interrupts();
+    InitGraphics();
+
+    BuildCycle();
+
+    // snake lengths from 1 to a full board: the longest snake can still grow
+    // without filling the board, which would end the game
+    const uint16_t lengths[] = {1,  2,  4,   8,   16,  32,
+                                64, 128, 192, 256, CYCLE_LENGTH - 2};
+
+    for (uint8_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        SetupSnake(lengths[i]);
+        Measure("move", OpMove, lengths[i]);
+        SetupSnake(lengths[i]);
+        Measure("grow", OpGrow, lengths[i]);
+        SetupSnake(lengths[i]);
+        Measure("loot", OpLoot, lengths[i]);
+        SetupSnake(lengths[i]);
+        AddRandomLoot(&state);
+        Measure("autopilot", OpAutopilot, lengths[i]);
+    }
+
+    SetupSnake(1);
+    Measure("collision", OpCollision, 0);
+    Measure("idle_tick", OpIdleTick, 0);
+    Measure("draw_cell", OpDrawCell, 0);
+    Measure("legend_score", OpLegendScore, 0);
+    Measure("legend_level", OpLegendLevel, 0);
+
+    PrintResults(CountAllocations());
+
+    if (baselinePath) {
+        int regressions = CompareResults(baselinePath, threshold);
+        if (regressions < 0) {
+            fprintf(stderr, "cannot read %s\n", baselinePath);
+            return 1;
+        }
+        return regressions ? 2 : 0;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,423 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <gb/gb.h>
+#include <gbt_player.h>
+#include <rand.h>
+#include <string.h>
+#include <time.h>
+
+#include "host.h"
+
+/** the maximum number of handlers of an interrupt (like GBDK) */
+#define MAX_HANDLERS 4
+
+/*************************************************
+**               public variables               **
+*************************************************/
+
+volatile uint8_t LCDC_REG = LCDCF_ON | LCDCF_WIN9C00 | LCDCF_BGON;
+volatile uint8_t STAT_REG;
+volatile uint8_t SCY_REG;
+volatile uint8_t SCX_REG;
+volatile uint8_t LY_REG;
+volatile uint8_t LYC_REG;
+volatile uint8_t BGP_REG;
+volatile uint8_t OBP0_REG;
+volatile uint8_t OBP1_REG;
+volatile uint8_t WY_REG;
+volatile uint8_t WX_REG;
+volatile uint8_t DIV_REG;
+volatile uint8_t IE_REG;
+volatile uint8_t NR50_REG;
+volatile uint8_t NR51_REG;
+volatile uint8_t NR52_REG;
+
+volatile uint8_t _current_bank = 1;
+
+uint8_t hostBkgTiles[HOST_TILE_COUNT * 16];
+uint8_t hostSpriteTiles[HOST_TILE_COUNT * 16];
+uint8_t hostMaps[2][HOST_MAP_SIZE * HOST_MAP_SIZE];
+
+HostSprite hostOam[HOST_SPRITE_COUNT];
+
+volatile OAM_item_t shadow_OAM[HOST_SPRITE_COUNT];
+
+/** silent stand-ins of the mod2gbt tracks, which only build with SDCC */
+const unsigned char* menu_music_Data[] = {NULL};
+const unsigned char* board_music_Data[] = {NULL};
+const unsigned char* game_over_music_Data[] = {NULL};
+
+/*************************************************
+**               private variables              **
+*************************************************/
+
+HostJoypadHandler joypadHandler;
+BOOLEAN isThrottled;
+BOOLEAN isInterruptEnabled;
+uint32_t frameCount;
+struct timespec nextFrameTime;
+
+int_handler vblHandlers[MAX_HANDLERS];
+int_handler lcdHandlers[MAX_HANDLERS];
+
+uint16_t randState = 1;
+
+/*************************************************
+**              private functions               **
+*************************************************/
+
+/**
+ * @brief Add a handler to the given handler list
+ *
+ * @param handlers the handler list
+ * @param h the handler to add
+ */
+void AddHandler(int_handler* handlers, int_handler h)
+{
+    for (uint8_t i = 0; i < MAX_HANDLERS; i++) {
+        if (handlers[i] == NULL) {
+            handlers[i] = h;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Remove a handler from the given handler list
+ *
+ * @param handlers the handler list
+ * @param h the handler to remove
+ */
+void RemoveHandler(int_handler* handlers, int_handler h)
+{
+    for (uint8_t i = 0; i < MAX_HANDLERS; i++)
+        if (handlers[i] == h) handlers[i] = NULL;
+}
+
+/**
+ * @brief Call every handler of the given handler list
+ *
+ * @param handlers the handler list
+ */
+void CallHandlers(int_handler* handlers)
+{
+    for (uint8_t i = 0; i < MAX_HANDLERS; i++)
+        if (handlers[i]) handlers[i]();
+}
+
+/**
+ * @brief Sleep until the next frame time to run at HOST_FRAME_RATE
+ *
+ */
+void WaitFrameTime()
+{
+    long frameNs = (long)(1e9 / HOST_FRAME_RATE);
+
+    if (nextFrameTime.tv_sec == 0)
+        clock_gettime(CLOCK_MONOTONIC, &nextFrameTime);
+
+    nextFrameTime.tv_nsec += frameNs;
+    if (nextFrameTime.tv_nsec >= 1000000000L) {
+        nextFrameTime.tv_nsec -= 1000000000L;
+        nextFrameTime.tv_sec++;
+    }
+
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &nextFrameTime, NULL);
+}
+
+/**
+ * @brief Copy 2bpp tiles to the given tile data block
+ *
+ * @param block the tile data block to write to
+ * @param first the index of the first tile to write
+ * @param count the number of tiles to write (0 means 256 tiles)
+ * @param data the 16 bytes of every tile
+ */
+void SetTileData(uint8_t* block, uint8_t first, uint8_t count,
+                 const uint8_t* data)
+{
+    uint16_t size = count ? count : HOST_TILE_COUNT;
+
+    // the block wraps around, like the 0x8800 addressing mode
+    for (uint16_t i = 0; i < size; i++, data += 16)
+        memcpy(block + ((first + i) & 0xFF) * 16, data, 16);
+}
+
+/**
+ * @brief Copy a w x h block of tiles to the given map
+ *
+ * @param map the map to write to
+ * @param x the x position of the block
+ * @param y the y position of the block
+ * @param w the width of the block
+ * @param h the height of the block
+ * @param tiles the tiles of the block, row by row
+ */
+void SetMapTiles(uint8_t* map, uint8_t x, uint8_t y, uint8_t w, uint8_t h,
+                 const uint8_t* tiles)
+{
+    for (uint8_t j = 0; j < h; j++)
+        for (uint8_t i = 0; i < w; i++)
+            map[((y + j) & 31) * HOST_MAP_SIZE + ((x + i) & 31)] = *tiles++;
+}
+
+/**
+ * @brief Get the map shown by the background.
+ *
+ * @return the map
+ */
+uint8_t* BkgMap()
+{
+    return hostMaps[(LCDC_REG & LCDCF_BG9C00) != 0];
+}
+
+/**
+ * @brief Get the map shown by the window.
+ *
+ * @return the map
+ */
+uint8_t* WinMap()
+{
+    return hostMaps[(LCDC_REG & LCDCF_WIN9C00) != 0];
+}
+
+/*************************************************
+**               public functions               **
+*************************************************/
+
+void HostSetJoypadHandler(HostJoypadHandler handler)
+{
+    joypadHandler = handler;
+}
+
+void HostSetThrottle(BOOLEAN throttle)
+{
+    isThrottled = throttle;
+    nextFrameTime.tv_sec = 0;
+}
+
+uint32_t HostGetFrameCount()
+{
+    return frameCount;
+}
+
+uint8_t joypad(void)
+{
+    return joypadHandler ? joypadHandler(frameCount) : 0;
+}
+
+void wait_vbl_done(void)
+{
+    if (isThrottled) WaitFrameTime();
+
+    frameCount++;
+
+    // DIV increments at 16384Hz, so about 274 times per frame
+    DIV_REG += 18;
+
+    // a frame has no scanlines on the host: the lines of the frame are
+    // reached just before the VBlank, with a STAT interrupt on the LYC line
+    // and on every HBlank when they are enabled. VRAM is always free.
+    if (isInterruptEnabled && (IE_REG & LCD_IFLAG)) {
+        for (LY_REG = 0; LY_REG < 144; LY_REG++) {
+            if (((STAT_REG & STATF_LYC) && LY_REG == LYC_REG) ||
+                (STAT_REG & STATF_MODE00))
+                CallHandlers(lcdHandlers);
+        }
+    }
+
+    LY_REG = 144;
+
+    // the OAM DMA of GBDK, which copies the shadow OAM once per VBlank
+    if (isInterruptEnabled && (IE_REG & VBL_IFLAG))
+        memcpy(hostOam, (const OAM_item_t*)shadow_OAM, sizeof(hostOam));
+
+    if (isInterruptEnabled && (IE_REG & VBL_IFLAG)) CallHandlers(vblHandlers);
+}
+
+void disable_interrupts(void)
+{
+    isInterruptEnabled = FALSE;
+}
+
+void enable_interrupts(void)
+{
+    isInterruptEnabled = TRUE;
+}
+
+void set_interrupts(uint8_t flags)
+{
+    IE_REG = flags;
+}
+
+void add_VBL(int_handler h)
+{
+    AddHandler(vblHandlers, h);
+}
+
+void add_LCD(int_handler h)
+{
+    AddHandler(lcdHandlers, h);
+}
+
+void remove_VBL(int_handler h)
+{
+    RemoveHandler(vblHandlers, h);
+}
+
+void remove_LCD(int_handler h)
+{
+    RemoveHandler(lcdHandlers, h);
+}
+
+void set_bkg_data(uint8_t first_tile, uint8_t nb_tiles, const uint8_t* data)
+{
+    SetTileData(hostBkgTiles, first_tile, nb_tiles, data);
+}
+
+void set_sprite_data(uint8_t first_tile, uint8_t nb_tiles,
+                     const uint8_t* data)
+{
+    SetTileData(hostSpriteTiles, first_tile, nb_tiles, data);
+}
+
+void set_bkg_tiles(uint8_t x, uint8_t y, uint8_t w, uint8_t h,
+                   const uint8_t* tiles)
+{
+    SetMapTiles(BkgMap(), x, y, w, h, tiles);
+}
+
+uint8_t* set_bkg_tile_xy(uint8_t x, uint8_t y, uint8_t t)
+{
+    uint8_t* tile = BkgMap() + (y & 31) * HOST_MAP_SIZE + (x & 31);
+    *tile = t;
+    return tile;
+}
+
+uint8_t get_bkg_tile_xy(uint8_t x, uint8_t y)
+{
+    return BkgMap()[(y & 31) * HOST_MAP_SIZE + (x & 31)];
+}
+
+void move_bkg(uint8_t x, uint8_t y)
+{
+    SCX_REG = x;
+    SCY_REG = y;
+}
+
+void scroll_bkg(int8_t x, int8_t y)
+{
+    SCX_REG += x;
+    SCY_REG += y;
+}
+
+void set_tiles(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t* vram_addr,
+               const uint8_t* tiles)
+{
+    SetMapTiles(vram_addr, x, y, w, h, tiles);
+}
+
+void set_win_tiles(uint8_t x, uint8_t y, uint8_t w, uint8_t h,
+                   const uint8_t* tiles)
+{
+    SetMapTiles(WinMap(), x, y, w, h, tiles);
+}
+
+uint8_t* set_win_tile_xy(uint8_t x, uint8_t y, uint8_t t)
+{
+    uint8_t* tile = WinMap() + (y & 31) * HOST_MAP_SIZE + (x & 31);
+    *tile = t;
+    return tile;
+}
+
+uint8_t get_win_tile_xy(uint8_t x, uint8_t y)
+{
+    return WinMap()[(y & 31) * HOST_MAP_SIZE + (x & 31)];
+}
+
+void move_win(uint8_t x, uint8_t y)
+{
+    WX_REG = x;
+    WY_REG = y;
+}
+
+void scroll_win(int8_t x, int8_t y)
+{
+    WX_REG += x;
+    WY_REG += y;
+}
+
+void set_sprite_tile(uint8_t nb, uint8_t tile)
+{
+    shadow_OAM[nb].tile = tile;
+}
+
+uint8_t get_sprite_tile(uint8_t nb)
+{
+    return shadow_OAM[nb].tile;
+}
+
+void set_sprite_prop(uint8_t nb, uint8_t prop)
+{
+    shadow_OAM[nb].prop = prop;
+}
+
+void move_sprite(uint8_t nb, uint8_t x, uint8_t y)
+{
+    shadow_OAM[nb].x = x;
+    shadow_OAM[nb].y = y;
+}
+
+void scroll_sprite(uint8_t nb, int8_t x, int8_t y)
+{
+    shadow_OAM[nb].x += x;
+    shadow_OAM[nb].y += y;
+}
+
+void hide_sprite(uint8_t nb)
+{
+    shadow_OAM[nb].y = 0;
+}
+
+void initrand(uint16_t seed)
+{
+    randState = seed;
+}
+
+uint8_t rand(void)
+{
+    return randw() >> 8;
+}
+
+uint16_t randw(void)
+{
+    // linear congruential generator, like the one of GBDK
+    randState = randState * 0x0D45 + 0x4D9F;
+    return randState;
+}
+
+void gbt_play(void* data, UINT8 bank, UINT8 speed)
+{
+    (void)data;
+    (void)bank;
+    (void)speed;
+}
+
+void gbt_pause(UINT8 pause)
+{
+    (void)pause;
+}
+
+void gbt_stop(void) {}
+
+void gbt_loop(UINT8 loop)
+{
+    (void)loop;
+}
+
+void gbt_update(void) {}
+
+void gbt_enable_channels(UINT8 channel_flags)
+{
+    (void)channel_flags;
+}
\ No newline at end of file
@@ -0,0 +1,333 @@
+/**
+ * @file headless.c
+ * @author Raphael Jouretz (rjouretz.com)
+ * @brief Run the unmodified game screens headlessly on the host, under
+ * scripted input, for throughput and soak tests
+ * @version 0.1
+ * @date 2023-06-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include <gb/gb.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "autopilot.h"
+#include "board.h"
+#include "engine.h"
+#include "gameover.h"
+#include "graphics.h"
+#include "host.h"
+#include "input.h"
+#include "menu.h"
+#include "replay.h"
+#include "sound.h"
+#include "utils.h"
+
+/** the maximum number of lines of an input script */
+#define MAX_SCRIPT_STEPS 1024
+
+/** a random direction is held RANDOM_HOLD_FRAMES frames plus up to
+ * RANDOM_HOLD_MASK more, several moves of the snake */
+#define RANDOM_HOLD_FRAMES 16
+#define RANDOM_HOLD_MASK   63
+
+/** the period of the START pulses. The menu restarts its fade out every
+ * frame START is pressed, so START must be released long enough. */
+#define START_PERIOD 64
+
+/*************************************************
+**                 structures                   **
+*************************************************/
+
+/** @struct ScriptStep
+ *  Represent a line of an input script: the joypad state held for a number
+ *  of frames.
+ *
+ *  @var ScriptStep::frames
+ *    The number of frames the joypad state is held.
+ *  @var ScriptStep::keys
+ *    The joypad state (J_* flags).
+ */
+typedef struct {
+    uint32_t frames;
+    uint8_t keys;
+} ScriptStep;
+
+/*************************************************
+**               private variables              **
+*************************************************/
+
+/** the game state, the replay and the autopilot of the board screen (see
+ * board.c) */
+extern EngineState engine;
+extern Replay replay;
+extern Autopilot autopilot;
+
+ScriptStep script[MAX_SCRIPT_STEPS];
+uint16_t scriptLength;
+uint32_t scriptFrames;
+uint32_t randomState;
+
+/*************************************************
+**              private functions               **
+*************************************************/
+
+/**
+ * @brief Parse joypad keys written as "UP+A+START" ("-" for no key)
+ *
+ * @param text the text to parse
+ * @return the joypad state (J_* flags)
+ */
+uint8_t ParseKeys(char* text)
+{
+    const char* names[] = {"RIGHT", "LEFT", "UP",     "DOWN",
+                           "A",     "B",    "SELECT", "START"};
+    uint8_t keys = 0;
+
+    for (char* key = strtok(text, "+\n"); key; key = strtok(NULL, "+\n"))
+        for (uint8_t i = 0; i < 8; i++)
+            if (strcmp(key, names[i]) == 0) keys |= 1U << i;
+
+    return keys;
+}
+
+/**
+ * @brief Load an input script. Every line is "<frames> <keys>", the script
+ * loops once finished.
+ *
+ * @param path the path of the script
+ * @return 0 on success, -1 otherwise
+ */
+int LoadScript(const char* path)
+{
+    FILE* file = fopen(path, "r");
+    if (!file) return -1;
+
+    char keys[64];
+    unsigned long frames;
+
+    while (scriptLength < MAX_SCRIPT_STEPS &&
+           fscanf(file, "%lu %63s", &frames, keys) == 2) {
+        script[scriptLength].frames = frames;
+        script[scriptLength].keys = ParseKeys(keys);
+        scriptFrames += frames;
+        scriptLength++;
+    }
+
+    fclose(file);
+    return scriptFrames ? 0 : -1;
+}
+
+/**
+ * @brief Give the joypad state of the loaded script at the given frame
+ *
+ * @param frame the frame
+ * @return the joypad state
+ */
+uint8_t ScriptJoypad(uint32_t frame)
+{
+    frame %= scriptFrames;
+
+    for (uint16_t i = 0; i < scriptLength; i++) {
+        if (frame < script[i].frames) return script[i].keys;
+        frame -= script[i].frames;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Get whether the snake can move once in a direction: the cell next
+ * to its head is empty or a loot.
+ *
+ * @param dir the direction (one of ENGINE_INPUTS)
+ * @return true if the move does not end the game
+ */
+BOOLEAN IsMoveFree(uint8_t dir)
+{
+    // no game was played yet
+    if (engine.snake.length == 0) return TRUE;
+
+    uint16_t pos = engine.snake.cells[engine.snake.head];
+
+    switch (dir) {
+        case INPUT_UP: pos -= BOARD_STRIDE; break;
+        case INPUT_DOWN: pos += BOARD_STRIDE; break;
+        case INPUT_RIGHT: pos++; break;
+        default: pos--; break;
+    }
+
+    return engine.cells[pos] == EMPTY_CELL || engine.cells[pos] == LOOT_CELL;
+}
+
+/**
+ * @brief Give a random direction held for a random number of frames, with
+ * START pressed once every START_PERIOD frames to leave the menu. A new
+ * direction is a turn from the one of the snake, never its opposite, and it
+ * is taken early when the snake is about to hit something, so the random
+ * games grow and level up.
+ *
+ * @param frame the frame
+ * @return the joypad state
+ */
+uint8_t RandomJoypad(uint32_t frame)
+{
+    static uint8_t keys;
+    static uint32_t holdEnd;
+
+    if (frame >= holdEnd || !IsMoveFree(engine.dir)) {
+        randomState = randomState * 1103515245U + 12345U;
+        uint8_t random = randomState >> 16;
+
+        // the two turns, in a random order: the first free one is taken
+        uint8_t turns = (engine.dir & (INPUT_RIGHT | INPUT_LEFT))
+                            ? INPUT_UP | INPUT_DOWN
+                            : INPUT_RIGHT | INPUT_LEFT;
+        uint8_t first = turns & (turns << 1);
+        uint8_t second = turns ^ first;
+        if (random & 1) {
+            first = second;
+            second = turns ^ first;
+        }
+
+        keys = IsMoveFree(first) || !IsMoveFree(second) ? first : second;
+        holdEnd = frame + RANDOM_HOLD_FRAMES + ((random >> 1) & RANDOM_HOLD_MASK);
+    }
+
+    return (frame % START_PERIOD == 0) ? keys | J_START : keys;
+}
+
+/**
+ * @brief Give the directions of the autopilot, with START pressed once every
+ * START_PERIOD frames to leave the menu.
+ *
+ * @param frame the frame
+ * @return the joypad state
+ */
+uint8_t AutopilotJoypad(uint32_t frame)
+{
+    uint8_t keys = NextAutopilotInput(&autopilot, &engine);
+
+    return (frame % START_PERIOD == 0) ? keys | J_START : keys;
+}
+
+/**
+ * @brief Save the replay of the last game to "<prefix><game>.rpl"
+ *
+ * @param prefix the path prefix of the replay files
+ * @param game the index of the game
+ * @return 0 on success, -1 otherwise
+ */
+int SaveReplay(const char* prefix, unsigned long game)
+{
+    char path[512];
+    snprintf(path, sizeof(path), "%s%lu.rpl", prefix, game);
+
+    FILE* file = fopen(path, "wb");
+    if (!file) return -1;
+
+    size_t size = fwrite(replay.data, 1, replay.size, file);
+    fclose(file);
+
+    return size == replay.size ? 0 : -1;
+}
+
+/**
+ * @brief Print the command usage
+ *
+ * @param name the name of the command
+ */
+void PrintUsage(const char* name)
+{
+    fprintf(stderr,
+            "usage: %s [-g games] [-s seed] [-i script] [-a] [-r prefix] [-t]\n"
+            "  -g games   number of games to play (default 100)\n"
+            "  -s seed    seed of the random input (default 1)\n"
+            "  -i script  play the input script instead of random input\n"
+            "  -a         play with the autopilot instead of random input\n"
+            "  -r prefix  save the replay of every game to <prefix><game>.rpl\n"
+            "  -t         throttle to the gameboy frame rate\n",
+            name);
+}
+
+/*************************************************
+**               public functions               **
+*************************************************/
+
+int main(int argc, char** argv)
+{
+    unsigned long games = 100;
+    const char* replayPrefix = NULL;
+    int opt;
+
+    randomState = 1;
+    HostSetJoypadHandler(RandomJoypad);
+
+    while ((opt = getopt(argc, argv, "g:s:i:ar:t")) != -1) {
+        switch (opt) {
+            case 'g': games = strtoul(optarg, NULL, 10); break;
+            case 's': randomState = strtoul(optarg, NULL, 10); break;
+            case 'i':
+                if (LoadScript(optarg) != 0) {
+                    fprintf(stderr, "cannot load script %s\n", optarg);
+                    return 1;
+                }
+                HostSetJoypadHandler(ScriptJoypad);
+                break;
+            case 'a': HostSetJoypadHandler(AutopilotJoypad); break;
+            case 'r': replayPrefix = optarg; break;
+            case 't': HostSetThrottle(TRUE); break;
+            default: PrintUsage(argv[0]); return 1;
+        }
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    InitSoundPlayer();
+    InitGraphics();
+    InitFrameScheduler();
+    InitInput();
+
+    unsigned long totalScore = 0;
+    uint16_t bestScore = 0;
+
+    for (unsigned long i = 0; i < games; i++) {
+        RunMenu();
+        RunBoard();
+
+        totalScore += engine.score;
+        if (engine.score > bestScore) bestScore = engine.score;
+
+        if (replayPrefix && SaveReplay(replayPrefix, i) != 0) {
+            fprintf(stderr, "cannot save the replay of game %lu\n", i);
+            return 1;
+        }
+
+        RunGameOver();
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double seconds =
+        (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    uint32_t frames = HostGetFrameCount();
+
+    printf("games: %lu\n", games);
+    printf("frames: %lu\n", (unsigned long)frames);
+    printf("seconds: %.3f\n", seconds);
+    printf("frames/s: %.0f (%.0fx real time)\n", frames / seconds,
+           frames / seconds / HOST_FRAME_RATE);
+    printf("mean score: %.2f\n", games ? (double)totalScore / games : 0.0);
+    printf("best score: %u\n", bestScore);
+    printf("lag frames: %u\n", GetLagFrameCount());
+
+    return 0;
+}
\ No newline at end of file
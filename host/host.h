@@ -0,0 +1,86 @@
+/**
+ * @file host.h
+ * @author Raphael Jouretz (rjouretz.com)
+ * @brief Access the emulated hardware of the host build (see gb/gb.h)
+ * @version 0.1
+ * @date 2023-06-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <stdint.h>
+#include <types.h>
+
+#ifndef HOST_H
+#define HOST_H
+
+/** the size of the background and window maps (in tiles) */
+#define HOST_MAP_SIZE     32
+
+/** the number of hardware sprites */
+#define HOST_SPRITE_COUNT 40
+
+/** the number of tiles of a tile data block */
+#define HOST_TILE_COUNT   256
+
+/** the gameboy frame rate */
+#define HOST_FRAME_RATE   59.73
+
+/** @struct HostSprite
+ *  Represent an OAM entry.
+ *
+ *  @var HostSprite::y
+ *    The y position of the sprite (16 is the top of the screen).
+ *  @var HostSprite::x
+ *    The x position of the sprite (8 is the left of the screen).
+ *  @var HostSprite::tile
+ *    The tile index of the sprite.
+ *  @var HostSprite::prop
+ *    The properties of the sprite.
+ */
+typedef struct {
+    uint8_t y, x;
+    uint8_t tile;
+    uint8_t prop;
+} HostSprite;
+
+/**
+ * @brief A function giving the joypad state at the given frame.
+ *
+ */
+typedef uint8_t (*HostJoypadHandler)(uint32_t frame);
+
+/** the VRAM of the host build */
+extern uint8_t hostBkgTiles[HOST_TILE_COUNT * 16];
+extern uint8_t hostSpriteTiles[HOST_TILE_COUNT * 16];
+/** the maps at _SCRN0 and _SCRN1, the LCDC flags select the background and
+ * the window ones */
+extern uint8_t hostMaps[2][HOST_MAP_SIZE * HOST_MAP_SIZE];
+
+/** the OAM of the host build, copied from shadow_OAM on every VBlank */
+extern HostSprite hostOam[HOST_SPRITE_COUNT];
+
+/**
+ * @brief Set the function giving the joypad state. joypad() returns 0
+ * while no handler is set.
+ *
+ * @param handler the handler to set (can be NULL)
+ */
+void HostSetJoypadHandler(HostJoypadHandler handler);
+
+/**
+ * @brief Enable or disable the wait of the real vblank duration in
+ * wait_vbl_done(). The host runs unthrottled by default.
+ *
+ * @param isThrottled true to run at the gameboy frame rate
+ */
+void HostSetThrottle(BOOLEAN isThrottled);
+
+/**
+ * @brief Get the number of frames (vblanks) since the start
+ *
+ * @return the number of frames
+ */
+uint32_t HostGetFrameCount();
+
+#endif
\ No newline at end of file
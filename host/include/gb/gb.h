@@ -0,0 +1,197 @@
+/**
+ * @file gb.h
+ * @author Raphael Jouretz (rjouretz.com)
+ * @brief Host stand-in for the part of the GBDK gb/gb.h header used by the
+ * game. VRAM, OAM and the registers are plain arrays and variables (see
+ * host.h to access them).
+ * @version 0.1
+ * @date 2023-06-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <stdint.h>
+#include <types.h>
+
+#ifndef HOST_GB_H
+#define HOST_GB_H
+
+/** GBDK calling convention and banking keywords mean nothing on the host */
+#define OLDCALL
+#define NONBANKED
+#define BANKED
+#define BANKREF(name)
+#define BANKREF_EXTERN(name)
+#define BANK(name) 0
+
+/** the host ROM is flat, switching the bank only records it */
+extern volatile uint8_t _current_bank;
+#define CURRENT_BANK  _current_bank
+#define SWITCH_ROM(b) (_current_bank = (b))
+
+typedef uint16_t palette_color_t;
+#define RGB8(r, g, b) \
+    ((((uint16_t)(b) >> 3) << 10) | (((uint16_t)(g) >> 3) << 5) | ((r) >> 3))
+
+/**
+ * @defgroup HOST_JOYPAD Joypad
+ * @{
+ */
+#define J_RIGHT  0x01U
+#define J_LEFT   0x02U
+#define J_UP     0x04U
+#define J_DOWN   0x08U
+#define J_A      0x10U
+#define J_B      0x20U
+#define J_SELECT 0x40U
+#define J_START  0x80U
+/** @} */
+
+/**
+ * @defgroup HOST_INTERRUPTS Interrupts
+ * @{
+ */
+#define VBL_IFLAG    0x01U
+#define LCD_IFLAG    0x02U
+#define TIM_IFLAG    0x04U
+#define SIO_IFLAG    0x08U
+#define JOY_IFLAG    0x10U
+/** @} */
+
+/**
+ * @defgroup HOST_REGISTERS Registers
+ * @{
+ */
+extern volatile uint8_t LCDC_REG;
+extern volatile uint8_t STAT_REG;
+extern volatile uint8_t SCY_REG;
+extern volatile uint8_t SCX_REG;
+extern volatile uint8_t LY_REG;
+extern volatile uint8_t LYC_REG;
+extern volatile uint8_t BGP_REG;
+extern volatile uint8_t OBP0_REG;
+extern volatile uint8_t OBP1_REG;
+extern volatile uint8_t WY_REG;
+extern volatile uint8_t WX_REG;
+extern volatile uint8_t DIV_REG;
+extern volatile uint8_t IE_REG;
+extern volatile uint8_t NR50_REG;
+extern volatile uint8_t NR51_REG;
+extern volatile uint8_t NR52_REG;
+/** @} */
+
+/**
+ * @defgroup HOST_STAT STAT flags
+ * @{
+ */
+#define STATF_LYC    0x40U
+#define STATF_MODE00 0x08U
+#define STATF_LYCF   0x04U
+#define STATF_BUSY   0x02U
+/** @} */
+
+/**
+ * @defgroup HOST_LCDC LCDC flags
+ * @{
+ */
+#define LCDCF_BGON     0x01U
+#define LCDCF_OBJON    0x02U
+#define LCDCF_OBJ16    0x04U
+#define LCDCF_BG9C00   0x08U
+#define LCDCF_BG8000   0x10U
+#define LCDCF_WINON    0x20U
+#define LCDCF_WIN9C00  0x40U
+#define LCDCF_ON       0x80U
+/** @} */
+
+/**
+ * @defgroup HOST_SCRN Map addresses
+ *
+ * @brief the maps are plain arrays on the host (see host.h), written through
+ * their addresses like VRAM
+ * @{
+ */
+extern uint8_t hostMaps[2][32 * 32];
+#define _SCRN0 ((uintptr_t)hostMaps[0])
+#define _SCRN1 ((uintptr_t)hostMaps[1])
+/** @} */
+
+/**
+ * @defgroup HOST_VRAM Tile data addresses
+ *
+ * @brief the tile data are plain arrays on the host too: the sprite tiles
+ * from _VRAM8000 and the background tiles from _VRAM9000 (the slots of the
+ * 0x9000 block are the first background tiles)
+ * @{
+ */
+extern uint8_t hostBkgTiles[256 * 16];
+extern uint8_t hostSpriteTiles[256 * 16];
+#define _VRAM8000 ((uintptr_t)hostSpriteTiles)
+#define _VRAM9000 ((uintptr_t)hostBkgTiles)
+/** @} */
+
+#define SHOW_BKG     LCDC_REG |= LCDCF_BGON
+#define HIDE_BKG     LCDC_REG &= ~LCDCF_BGON
+#define SHOW_WIN     LCDC_REG |= LCDCF_WINON
+#define HIDE_WIN     LCDC_REG &= ~LCDCF_WINON
+#define SHOW_SPRITES LCDC_REG |= LCDCF_OBJON
+#define HIDE_SPRITES LCDC_REG &= ~LCDCF_OBJON
+#define DISPLAY_ON   LCDC_REG |= LCDCF_ON
+#define DISPLAY_OFF  LCDC_REG &= ~LCDCF_ON
+
+/**
+ * @brief An entry of the shadow OAM. Like GBDK, the VBlank interrupt copies
+ * the shadow OAM to the OAM (see host.h) before the VBL handlers.
+ *
+ */
+typedef struct OAM_item_t {
+    uint8_t y, x;
+    uint8_t tile;
+    uint8_t prop;
+} OAM_item_t;
+
+extern volatile struct OAM_item_t shadow_OAM[];
+
+typedef void (*int_handler)(void);
+
+uint8_t joypad(void);
+void wait_vbl_done(void);
+#define vsync wait_vbl_done
+
+void disable_interrupts(void);
+void enable_interrupts(void);
+void set_interrupts(uint8_t flags);
+void add_VBL(int_handler h);
+void add_LCD(int_handler h);
+void remove_VBL(int_handler h);
+void remove_LCD(int_handler h);
+
+void set_bkg_data(uint8_t first_tile, uint8_t nb_tiles, const uint8_t* data);
+void set_sprite_data(uint8_t first_tile, uint8_t nb_tiles,
+                     const uint8_t* data);
+
+void set_bkg_tiles(uint8_t x, uint8_t y, uint8_t w, uint8_t h,
+                   const uint8_t* tiles);
+uint8_t* set_bkg_tile_xy(uint8_t x, uint8_t y, uint8_t t);
+uint8_t get_bkg_tile_xy(uint8_t x, uint8_t y);
+void move_bkg(uint8_t x, uint8_t y);
+void scroll_bkg(int8_t x, int8_t y);
+
+void set_tiles(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t* vram_addr,
+               const uint8_t* tiles);
+
+void set_win_tiles(uint8_t x, uint8_t y, uint8_t w, uint8_t h,
+                   const uint8_t* tiles);
+uint8_t* set_win_tile_xy(uint8_t x, uint8_t y, uint8_t t);
+uint8_t get_win_tile_xy(uint8_t x, uint8_t y);
+void move_win(uint8_t x, uint8_t y);
+void scroll_win(int8_t x, int8_t y);
+
+void set_sprite_tile(uint8_t nb, uint8_t tile);
+uint8_t get_sprite_tile(uint8_t nb);
+void set_sprite_prop(uint8_t nb, uint8_t prop);
+void move_sprite(uint8_t nb, uint8_t x, uint8_t y);
+void scroll_sprite(uint8_t nb, int8_t x, int8_t y);
+void hide_sprite(uint8_t nb);
+
+#endif
\ No newline at end of file
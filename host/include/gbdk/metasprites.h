@@ -0,0 +1,26 @@
+/**
+ * @file metasprites.h
+ * @author Raphael Jouretz (rjouretz.com)
+ * @brief Host stand-in for the GBDK gbdk/metasprites.h header, included by
+ * the png2asset generated resources
+ * @version 0.1
+ * @date 2023-06-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <stdint.h>
+
+#ifndef HOST_METASPRITES_H
+#define HOST_METASPRITES_H
+
+typedef struct {
+    int8_t dy, dx;
+    uint8_t dtile;
+    uint8_t props;
+} metasprite_t;
+
+#define METASPR_ITEM(dy, dx, dt, a) {(dy), (dx), (dt), (a)}
+#define METASPR_TERM                {-128, 0, 0, 0}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,12 @@
+/**
+ * @file platform.h
+ * @author Raphael Jouretz (rjouretz.com)
+ * @brief Host stand-in for the GBDK gbdk/platform.h header, included by the
+ * png2asset generated resources
+ * @version 0.1
+ * @date 2023-06-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <gb/gb.h>
\ No newline at end of file
@@ -0,0 +1,38 @@
+/**
+ * @file rand.h
+ * @author Raphael Jouretz (rjouretz.com)
+ * @brief Host stand-in for the GBDK rand.h header
+ * @version 0.1
+ * @date 2023-06-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <stdint.h>
+
+#ifndef HOST_RAND_H
+#define HOST_RAND_H
+
+/**
+ * @brief Initialize the random number generator
+ *
+ * @param seed the seed of the generator
+ */
+void initrand(uint16_t seed);
+
+/**
+ * @brief Get a random 8 bits number. The host rand() of the C library is
+ * replaced by this one, like with GBDK.
+ *
+ * @return the random number
+ */
+uint8_t rand(void);
+
+/**
+ * @brief Get a random 16 bits number
+ *
+ * @return the random number
+ */
+uint16_t randw(void);
+
+#endif
\ No newline at end of file
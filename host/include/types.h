@@ -0,0 +1,31 @@
+/**
+ * @file types.h
+ * @author Raphael Jouretz (rjouretz.com)
+ * @brief Host stand-in for the GBDK types.h header
+ * @version 0.1
+ * @date 2023-06-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <stdint.h>
+
+#ifndef HOST_TYPES_H
+#define HOST_TYPES_H
+
+#define TRUE  1
+#define FALSE 0
+
+/** the host interrupts only run from wait_vbl_done, a critical section
+ * (SDCC __critical on the gameboy) has nothing to mask */
+#define CRITICAL
+
+typedef int8_t BOOLEAN;
+typedef int8_t INT8;
+typedef uint8_t UINT8;
+typedef int16_t INT16;
+typedef uint16_t UINT16;
+typedef uint8_t UBYTE;
+typedef uint16_t UWORD;
+
+#endif
\ No newline at end of file
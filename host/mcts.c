@@ -0,0 +1,712 @@
+/**
+ * @file mcts.c
+ * @author Raphael Jouretz (rjouretz.com)
+ * @brief Play seeded games with a parallel Monte Carlo tree search over the
+ * engine rules and print the results (JSON), as a strong play reference
+ * @version 0.1
+ * @date 2023-06-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * The tree is open loop: a node is a sequence of moves from the root, not a
+ * board. Every rollout replays the moves of its path on a copy of the root
+ * state whose random generator is reseeded, so the loot drops (lootTimer
+ * and AddRandomLoot) are sampled as the player sees them: unknown.
+ *
+ * The workers share the tree without locks: the statistics are atomic
+ * counters, a visit is counted on the way down (so the other workers avoid
+ * the same path until the reward is added on the way up), and a child is
+ * published with a compare and swap.
+ *
+ * The search runs on the tick the snake moves, so it sees the loot drops of
+ * the ticks before the move, as the autopilot does. The root only searches
+ * the moves after which the autopilot survives its lookahead: the rollouts
+ * choose between them for the loots, the short rollouts cannot see a trap
+ * that closes many moves later. A single safe move is played without a
+ * search, and without any the autopilot chooses the move.
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include <math.h>
+#include <pthread.h>
+#include <resources/levels.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "autopilot.h"
+#include "engine.h"
+
+/** the number of possible scores (the score is at most the snake length) */
+#define SCORE_COUNT (SNAKE_CAPACITY + 1)
+
+/** the number of possible moves from a node (indexed by direction bit) */
+#define MOVE_COUNT 4
+
+/** the fixed point unit of the rewards */
+#define REWARD_ONE 65536
+
+/** the exploration constant of UCT, for rewards in [0, 1] */
+#define EXPLORATION 0.7
+
+/** the maximum number of moves from the root to a leaf */
+#define MAX_TREE_DEPTH 256
+
+/*************************************************
+**                 structures                   **
+*************************************************/
+
+/** @struct Node
+ *  Represent a node of the search tree, the move leading to it is the index
+ *  of the node in the children of its parent.
+ *
+ *  @var Node::children
+ *    The index of the child of every move, 0 if not expanded (the index 0
+ *    is the root).
+ *  @var Node::visits
+ *    The number of rollouts through the node.
+ *  @var Node::reward
+ *    The sum of the rewards of the rollouts (REWARD_ONE fixed point).
+ */
+typedef struct {
+    uint32_t children[MOVE_COUNT];
+    uint32_t visits;
+    uint64_t reward;
+} Node;
+
+/** @struct Worker
+ *  Represent a search thread with its own game state.
+ *
+ *  @var Worker::thread
+ *    The thread of the worker.
+ *  @var Worker::state
+ *    The game state of the rollouts.
+ *  @var Worker::random
+ *    The random generator of the rollouts and of the loot drops.
+ */
+typedef struct {
+    pthread_t thread;
+    EngineState state;
+    uint64_t random;
+} Worker;
+
+/*************************************************
+**               private variables              **
+*************************************************/
+
+Worker* workers;
+unsigned workerCount;
+pthread_barrier_t startBarrier;
+pthread_barrier_t endBarrier;
+int isStopped;
+
+/** the two node pools: the tree and the copy target of the reused subtree */
+Node* pools[2];
+Node* nodes;
+uint32_t nodeCapacity;
+uint32_t nodeCount;
+
+/** the state of the root, the rollouts left and the search settings */
+EngineState rootState;
+int64_t rolloutsLeft;
+uint64_t rolloutsPerMove = 2000;
+uint8_t rolloutDepth = 16;
+
+/** the index of the level of the games */
+unsigned level;
+
+/** the autopilot that checks the moves of the root, and plays the games
+ * the search is compared to (-a) */
+Autopilot autopilot;
+
+/** the moves searched from the root (INPUT_* directions) */
+uint8_t rootMoves;
+
+/*************************************************
+**              private functions               **
+*************************************************/
+
+/**
+ * @brief Get the next number of a random generator (xorshift64)
+ *
+ * @param random the state of the generator
+ * @return the next number
+ */
+uint32_t NextRandom64(uint64_t* random)
+{
+    uint64_t x = *random;
+
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+
+    *random = x;
+    return x >> 32;
+}
+
+/**
+ * @brief Get the input of a move index.
+ *
+ * @param move the move index
+ * @return the INPUT_* direction
+ */
+uint8_t MoveInput(uint8_t move)
+{
+    return 1U << move;
+}
+
+/**
+ * @brief Get the move index of an input.
+ *
+ * @param input an INPUT_* direction
+ * @return the move index
+ */
+uint8_t MoveIndex(uint8_t input)
+{
+    return __builtin_ctz(input);
+}
+
+/**
+ * @brief Check if a move turns the snake back (ignored by the engine).
+ *
+ * @param state the game state
+ * @param move the move index
+ * @return non zero if the move is the opposite of the direction
+ */
+int IsBackMove(const EngineState* state, uint8_t move)
+{
+    uint8_t dir = MoveInput(move);
+
+    return (dir | state->dir) == (INPUT_RIGHT | INPUT_LEFT) ||
+           (dir | state->dir) == (INPUT_UP | INPUT_DOWN);
+}
+
+/**
+ * @brief Step the engine with a direction until the snake moves.
+ *
+ * @param state the game state
+ * @param move the move index
+ */
+void PlayMove(EngineState* state, uint8_t move)
+{
+    uint8_t input = MoveInput(move);
+
+    while (!state->isOver && !(StepEngine(state, input) & EVENT_MOVED))
+        ;
+}
+
+/**
+ * @brief Step the engine without input until the tick that moves the snake.
+ *
+ * @param state the game state
+ */
+void WaitMoveTick(EngineState* state)
+{
+    while (!state->isOver && !IS_MOVE_TICK(state)) StepEngine(state, 0);
+}
+
+/**
+ * @brief Get the packed position of the head after a move.
+ *
+ * @param state the game state
+ * @param move the move index
+ * @return the packed position
+ */
+uint16_t NextHead(const EngineState* state, uint8_t move)
+{
+    uint16_t head = state->snake.cells[state->snake.head];
+
+    switch (MoveInput(move)) {
+        case INPUT_UP: return head - BOARD_STRIDE;
+        case INPUT_DOWN: return head + BOARD_STRIDE;
+        case INPUT_RIGHT: return head + 1;
+        default: return head - 1;
+    }
+}
+
+/**
+ * @brief Choose a move of a rollout: a move that does not collide, most of
+ * the times the one closest to the last loot.
+ *
+ * @param state the game state
+ * @param random the random generator of the rollout
+ * @return the move index
+ */
+uint8_t RolloutMove(const EngineState* state, uint64_t* random)
+{
+    uint8_t safeMoves[MOVE_COUNT];
+    uint8_t safeCount = 0;
+    uint8_t bestMove = 0;
+    int bestDist = 1 << 30;
+    int hasLoot = state->cells[state->lastLoot] == LOOT_CELL;
+
+    for (uint8_t move = 0; move < MOVE_COUNT; move++) {
+        if (IsBackMove(state, move)) continue;
+
+        uint16_t pos = NextHead(state, move);
+        uint8_t cell = state->cells[pos];
+        if (cell != EMPTY_CELL && cell != LOOT_CELL) continue;
+
+        int dist = 0;
+        if (hasLoot)
+            dist = abs(POSITION_X(pos) - POSITION_X(state->lastLoot)) +
+                   abs(POSITION_Y(pos) - POSITION_Y(state->lastLoot));
+
+        if (dist < bestDist) {
+            bestDist = dist;
+            bestMove = move;
+        }
+        safeMoves[safeCount++] = move;
+    }
+
+    // every move collides, the direction does not matter
+    if (safeCount == 0) return bestMove;
+
+    uint32_t r = NextRandom64(random);
+    if (r & 3) return bestMove;
+    return safeMoves[(r >> 2) % safeCount];
+}
+
+/**
+ * @brief Get the reward of a rollout, in [0, REWARD_ONE]: half for
+ * surviving, half growing with the eaten loots.
+ *
+ * @param state the state at the end of the rollout
+ * @return the fixed point reward
+ */
+uint64_t RolloutReward(const EngineState* state)
+{
+    uint16_t gained = state->score - rootState.score;
+    uint64_t reward = (uint64_t)REWARD_ONE / 2 * gained / (gained + 1);
+
+    if (!state->isOver || state->snake.length == state->boardCellCount)
+        reward += REWARD_ONE / 2;
+
+    return reward;
+}
+
+/**
+ * @brief Allocate and publish the child of a node.
+ *
+ * @param parent the parent node
+ * @param move the move index of the child
+ * @return the index of the child, 0 if the pool is full
+ */
+uint32_t ExpandNode(Node* parent, uint8_t move)
+{
+    uint32_t index = __atomic_fetch_add(&nodeCount, 1, __ATOMIC_RELAXED);
+    if (index >= nodeCapacity) return 0;
+
+    Node* child = &nodes[index];
+    memset(child, 0, sizeof(Node));
+
+    // an other worker may have expanded the same move: keep its child, the
+    // allocated node is lost until the next compaction
+    uint32_t expected = 0;
+    if (!__atomic_compare_exchange_n(&parent->children[move], &expected,
+                                     index, 0, __ATOMIC_RELEASE,
+                                     __ATOMIC_ACQUIRE))
+        return expected;
+
+    return index;
+}
+
+/**
+ * @brief Choose the move to follow from a node (UCT). Unexpanded moves are
+ * tried first, in a random order.
+ *
+ * @param node the node
+ * @param state the game state at the node
+ * @param moves the moves that can be followed (INPUT_* directions)
+ * @param random the random generator of the worker
+ * @return the move index
+ */
+uint8_t SelectMove(const Node* node, const EngineState* state, uint8_t moves,
+                   uint64_t* random)
+{
+    uint8_t first = NextRandom64(random) % MOVE_COUNT;
+    double logVisits = log(__atomic_load_n(&node->visits, __ATOMIC_RELAXED));
+    double bestScore = -1;
+    uint8_t bestMove = 0;
+
+    for (uint8_t i = 0; i < MOVE_COUNT; i++) {
+        uint8_t move = (first + i) % MOVE_COUNT;
+        if (IsBackMove(state, move) || !(moves & MoveInput(move))) continue;
+
+        uint32_t index =
+            __atomic_load_n(&node->children[move], __ATOMIC_ACQUIRE);
+        if (index == 0) return move;
+
+        const Node* child = &nodes[index];
+        uint32_t visits = __atomic_load_n(&child->visits, __ATOMIC_RELAXED);
+        uint64_t reward = __atomic_load_n(&child->reward, __ATOMIC_RELAXED);
+
+        // a child is published before its first visit is counted
+        if (visits == 0) return move;
+
+        double score = (double)reward / REWARD_ONE / visits +
+                       EXPLORATION * sqrt(logVisits / visits);
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = move;
+        }
+    }
+
+    return bestMove;
+}
+
+/**
+ * @brief Run a rollout: follow the tree from the root, expand a node, play
+ * the rollout policy and add the reward to the path.
+ *
+ * @param worker the worker
+ */
+void RunRollout(Worker* worker)
+{
+    EngineState* state = &worker->state;
+    uint32_t path[MAX_TREE_DEPTH + 1];
+    uint16_t depth = 0;
+
+    memcpy(state, &rootState, sizeof(EngineState));
+
+    // the loot drops are unknown to the player: sample them
+    state->random = NextRandom64(&worker->random) | 1;
+
+    path[depth++] = 0;
+    __atomic_fetch_add(&nodes[0].visits, 1, __ATOMIC_RELAXED);
+
+    // selection and expansion
+    while (!state->isOver && depth <= MAX_TREE_DEPTH) {
+        Node* node = &nodes[path[depth - 1]];
+        uint8_t moves = depth == 1 ? rootMoves : 0xFF;
+        uint8_t move = SelectMove(node, state, moves, &worker->random);
+        uint32_t index =
+            __atomic_load_n(&node->children[move], __ATOMIC_ACQUIRE);
+        int isNew = index == 0;
+
+        if (isNew) index = ExpandNode(node, move);
+        if (index == 0) break;
+
+        PlayMove(state, move);
+        path[depth++] = index;
+        __atomic_fetch_add(&nodes[index].visits, 1, __ATOMIC_RELAXED);
+
+        if (isNew) break;
+    }
+
+    // simulation
+    for (uint8_t i = 0; i < rolloutDepth && !state->isOver; i++)
+        PlayMove(state, RolloutMove(state, &worker->random));
+
+    // backpropagation
+    uint64_t reward = RolloutReward(state);
+    for (uint16_t i = 0; i < depth; i++)
+        __atomic_fetch_add(&nodes[path[i]].reward, reward, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief The thread function of a worker: run rollouts between the start
+ * and the end barrier of every move.
+ *
+ * @param arg the worker
+ * @return NULL
+ */
+void* RunWorker(void* arg)
+{
+    Worker* worker = arg;
+
+    while (1) {
+        pthread_barrier_wait(&startBarrier);
+        if (isStopped) return NULL;
+
+        while (__atomic_sub_fetch(&rolloutsLeft, 1, __ATOMIC_RELAXED) >= 0)
+            RunRollout(worker);
+
+        pthread_barrier_wait(&endBarrier);
+    }
+}
+
+/**
+ * @brief Copy a subtree to the other pool (depth first).
+ *
+ * @param src the pool of the subtree
+ * @param index the index of the subtree root in src
+ * @param dst the pool to copy to, with nodeCount nodes used
+ * @return the index of the copy in dst
+ */
+uint32_t CopySubtree(const Node* src, uint32_t index, Node* dst)
+{
+    uint32_t copy = nodeCount++;
+
+    dst[copy] = src[index];
+
+    for (uint8_t move = 0; move < MOVE_COUNT; move++) {
+        if (src[index].children[move])
+            dst[copy].children[move] =
+                CopySubtree(src, src[index].children[move], dst);
+    }
+
+    return copy;
+}
+
+/**
+ * @brief Keep the subtree of the played move as the new tree.
+ *
+ * @param move the played move
+ * @return the number of reused nodes
+ */
+uint32_t ReuseSubtree(uint8_t move)
+{
+    Node* src = nodes;
+    Node* dst = nodes == pools[0] ? pools[1] : pools[0];
+    uint32_t child = src[0].children[move];
+
+    nodeCount = 0;
+    nodes = dst;
+
+    if (child)
+        CopySubtree(src, child, dst);
+    else {
+        memset(&dst[0], 0, sizeof(Node));
+        nodeCount = 1;
+    }
+
+    return child ? nodeCount : 0;
+}
+
+/**
+ * @brief Search the best move from the root state, among the moves the
+ * autopilot survives.
+ *
+ * @return the move index with the most visits
+ */
+uint8_t SearchMove()
+{
+    rootMoves = 0;
+    for (uint8_t move = 0; move < MOVE_COUNT; move++) {
+        if (IsAutopilotMoveSafe(&autopilot, &rootState, MoveInput(move)))
+            rootMoves |= MoveInput(move);
+    }
+
+    if (rootMoves == 0)
+        return MoveIndex(NextAutopilotInput(&autopilot, &rootState));
+    if (!(rootMoves & (rootMoves - 1))) return MoveIndex(rootMoves);
+
+    rolloutsLeft = rolloutsPerMove;
+
+    pthread_barrier_wait(&startBarrier);
+    pthread_barrier_wait(&endBarrier);
+
+    uint8_t bestMove = 0;
+    uint32_t bestVisits = 0;
+
+    for (uint8_t move = 0; move < MOVE_COUNT; move++) {
+        uint32_t index = nodes[0].children[move];
+        if (!(rootMoves & MoveInput(move)) || !index) continue;
+
+        if (nodes[index].visits > bestVisits) {
+            bestVisits = nodes[index].visits;
+            bestMove = move;
+        }
+    }
+
+    return bestMove;
+}
+
+/**
+ * @brief Play a game with the autopilot alone.
+ *
+ * @param state the game state
+ * @param seed the seed of the game
+ * @param maxMoves the maximum moves of the game
+ */
+void PlayAutopilotGame(EngineState* state, uint16_t seed,
+                       unsigned long maxMoves)
+{
+    InitEngine(state, levels[level], seed, NULL);
+    ResetAutopilot(&autopilot);
+
+    for (unsigned long moves = 0; !state->isOver && moves < maxMoves;) {
+        uint8_t input = 0;
+
+        if (IS_MOVE_TICK(state)) {
+            input = NextAutopilotInput(&autopilot, state);
+            moves++;
+        }
+        StepEngine(state, input);
+    }
+}
+
+/**
+ * @brief Print the command usage
+ *
+ * @param name the name of the command
+ */
+void PrintUsage(const char* name)
+{
+    fprintf(stderr,
+            "usage: %s [-g games] [-s seed] [-j threads] [-r rollouts] "
+            "[-d depth] [-n nodes] [-m moves] [-l level] [-a]\n"
+            "  -g games     number of games to play (default 4)\n"
+            "  -s seed      first seed, the seeds go up to %u (default 1)\n"
+            "  -j threads   number of threads (default: number of cores)\n"
+            "  -r rollouts  rollouts per move (default 2000)\n"
+            "  -d depth     moves of the rollout policy (default 16)\n"
+            "  -n nodes     nodes of a pool (default 1048576)\n"
+            "  -m moves     maximum moves of a game (default 100000)\n"
+            "  -l level     index of the level, below %d (default 0)\n"
+            "  -a           play the seeds with the autopilot too, the exit "
+            "code is 2\n"
+            "               if the search scores less on average\n",
+            name, SEED_COUNT, LEVEL_COUNT);
+}
+
+/*************************************************
+**               public functions               **
+*************************************************/
+
+int main(int argc, char** argv)
+{
+    unsigned long games = 4;
+    unsigned long firstSeed = 1;
+    unsigned long maxMoves = 100000;
+    int isCompared = 0;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int opt;
+
+    workerCount = cores > 0 ? (unsigned)cores : 1;
+    nodeCapacity = 1 << 20;
+
+    while ((opt = getopt(argc, argv, "g:s:j:r:d:n:m:l:a")) != -1) {
+        switch (opt) {
+            case 'g': games = strtoul(optarg, NULL, 10); break;
+            case 's': firstSeed = strtoul(optarg, NULL, 10); break;
+            case 'j': workerCount = strtoul(optarg, NULL, 10); break;
+            case 'r': rolloutsPerMove = strtoull(optarg, NULL, 10); break;
+            case 'd': rolloutDepth = strtoul(optarg, NULL, 10); break;
+            case 'n': nodeCapacity = strtoul(optarg, NULL, 10); break;
+            case 'm': maxMoves = strtoul(optarg, NULL, 10); break;
+            case 'l': level = strtoul(optarg, NULL, 10); break;
+            case 'a': isCompared = 1; break;
+            default: PrintUsage(argv[0]); return 1;
+        }
+    }
+
+    // the engine has SEED_COUNT different games, a seed out of them would
+    // play one of them again
+    if (workerCount == 0 || nodeCapacity == 0 || level >= LEVEL_COUNT ||
+        firstSeed == 0 || firstSeed > SEED_COUNT ||
+        games > SEED_COUNT + 1 - firstSeed) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    pools[0] = malloc(nodeCapacity * sizeof(Node));
+    pools[1] = malloc(nodeCapacity * sizeof(Node));
+    workers = calloc(workerCount, sizeof(Worker));
+    if (!pools[0] || !pools[1] || !workers) {
+        fprintf(stderr, "cannot allocate the nodes\n");
+        return 1;
+    }
+
+    pthread_barrier_init(&startBarrier, NULL, workerCount + 1);
+    pthread_barrier_init(&endBarrier, NULL, workerCount + 1);
+
+    for (unsigned i = 0; i < workerCount; i++) {
+        workers[i].random = 0x9E3779B97F4A7C15ULL * (i + 1);
+        pthread_create(&workers[i].thread, NULL, RunWorker, &workers[i]);
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    uint64_t scores[SCORE_COUNT] = {0};
+    uint64_t totalMoves = 0;
+    uint64_t reusedNodes = 0;
+    uint64_t wins = 0;
+    uint16_t bestScore = 0;
+
+    for (unsigned long game = 0; game < games; game++) {
+        InitEngine(&rootState, levels[level], firstSeed + game, NULL);
+        ResetAutopilot(&autopilot);
+        WaitMoveTick(&rootState);
+
+        nodes = pools[0];
+        memset(&nodes[0], 0, sizeof(Node));
+        nodeCount = 1;
+
+        unsigned long moves = 0;
+
+        while (!rootState.isOver && moves < maxMoves) {
+            uint8_t move = SearchMove();
+
+            PlayMove(&rootState, move);
+            WaitMoveTick(&rootState);
+            reusedNodes += ReuseSubtree(move);
+            moves++;
+        }
+
+        totalMoves += moves;
+        scores[rootState.score]++;
+        if (rootState.score > bestScore) bestScore = rootState.score;
+        if (rootState.snake.length == rootState.boardCellCount) wins++;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    isStopped = 1;
+    pthread_barrier_wait(&startBarrier);
+    for (unsigned i = 0; i < workerCount; i++)
+        pthread_join(workers[i].thread, NULL);
+
+    double seconds =
+        (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    uint64_t totalScore = 0;
+    for (int i = 0; i < SCORE_COUNT; i++) totalScore += scores[i] * i;
+
+    printf("{\n");
+    printf("  \"threads\": %u,\n", workerCount);
+    printf("  \"games\": %lu,\n", games);
+    printf("  \"rollouts_per_move\": %llu,\n",
+           (unsigned long long)rolloutsPerMove);
+    printf("  \"rollout_depth\": %u,\n", rolloutDepth);
+    printf("  \"seconds\": %.3f,\n", seconds);
+    printf("  \"rollouts_per_second\": %.0f,\n",
+           totalMoves * rolloutsPerMove / seconds);
+    printf("  \"mean_moves\": %.1f,\n",
+           games ? (double)totalMoves / games : 0.0);
+    printf("  \"reused_nodes_per_move\": %.1f,\n",
+           totalMoves ? (double)reusedNodes / totalMoves : 0.0);
+    printf("  \"mean_score\": %.3f,\n",
+           games ? (double)totalScore / games : 0.0);
+    printf("  \"best_score\": %u,\n", bestScore);
+    printf("  \"wins\": %llu,\n", (unsigned long long)wins);
+
+    // the same seeds played by the autopilot alone
+    uint64_t autopilotScore = 0;
+    if (isCompared) {
+        for (unsigned long game = 0; game < games; game++) {
+            PlayAutopilotGame(&rootState, firstSeed + game, maxMoves);
+            autopilotScore += rootState.score;
+        }
+        printf("  \"autopilot_mean_score\": %.3f,\n",
+               games ? (double)autopilotScore / games : 0.0);
+    }
+
+    const char* separator = "";
+    printf("  \"scores\": {");
+    for (int i = 0; i < SCORE_COUNT; i++) {
+        if (!scores[i]) continue;
+        printf("%s\"%d\": %llu", separator, i, (unsigned long long)scores[i]);
+        separator = ", ";
+    }
+    printf("}\n}\n");
+
+    free(workers);
+    free(pools[0]);
+    free(pools[1]);
+    return isCompared && totalScore < autopilotScore ? 2 : 0;
+}
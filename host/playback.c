@@ -0,0 +1,206 @@
+/**
+ * @file playback.c
+ * @author Raphael Jouretz (rjouretz.com)
+ * @brief Play replays at maximum speed and check that their final board and
+ * score match the recorded ones
+ * @version 0.1
+ * @date 2023-06-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include <resources/levels.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "engine.h"
+#include "replay.h"
+
+/** the number of ticks a random direction is held when recording */
+#define RANDOM_HOLD_TICKS 24
+
+/*************************************************
+**               private variables              **
+*************************************************/
+
+EngineState state;
+Replay replay;
+
+/*************************************************
+**              private functions               **
+*************************************************/
+
+/**
+ * @brief Load a replay file
+ *
+ * @param path the path of the file
+ * @return 0 on success, -1 otherwise
+ */
+int LoadReplay(const char* path)
+{
+    FILE* file = fopen(path, "rb");
+    if (!file) return -1;
+
+    replay.size = fread(replay.data, 1, REPLAY_CAPACITY, file);
+    fclose(file);
+
+    return 0;
+}
+
+/**
+ * @brief Save the replay to a file
+ *
+ * @param path the path of the file
+ * @return 0 on success, -1 otherwise
+ */
+int SaveReplay(const char* path)
+{
+    FILE* file = fopen(path, "wb");
+    if (!file) return -1;
+
+    size_t size = fwrite(replay.data, 1, replay.size, file);
+    fclose(file);
+
+    return size == replay.size ? 0 : -1;
+}
+
+/**
+ * @brief Play the loaded replay and check its final state
+ *
+ * @return "OK", or the reason of the failure
+ */
+const char* VerifyReplay()
+{
+    if (!StartReplayPlay(&replay))
+        return replay.isTruncated ? "TRUNCATED" : "INVALID";
+
+    if (GetReplayLevel(&replay) >= LEVEL_COUNT) return "UNKNOWN LEVEL";
+
+    InitEngine(&state, levels[GetReplayLevel(&replay)], GetReplaySeed(&replay),
+               NULL);
+
+    uint8_t input;
+    while (!state.isOver && NextReplayInput(&replay, &input))
+        StepEngine(&state, input);
+
+    return CheckReplay(&replay, &state) ? "OK" : "MISMATCH";
+}
+
+/**
+ * @brief Record a game played with random directions
+ *
+ * @param level the index of the level of the game
+ * @param seed the seed of the game and of the random directions
+ */
+void RecordRandomGame(uint8_t level, uint16_t seed)
+{
+    uint32_t random = seed;
+    uint8_t input = INPUT_RIGHT;
+
+    InitEngine(&state, levels[level], seed, NULL);
+    StartReplayRecord(&replay, level, seed);
+
+    for (uint32_t tick = 0; !state.isOver; tick++) {
+        if (tick % RANDOM_HOLD_TICKS == 0) {
+            random = random * 1103515245U + 12345U;
+            input = 1U << ((random >> 16) & 3);
+        }
+
+        RecordReplayInput(&replay, input);
+        StepEngine(&state, input);
+    }
+
+    FinishReplayRecord(&replay, &state);
+}
+
+/**
+ * @brief Print the command usage
+ *
+ * @param name the name of the command
+ */
+void PrintUsage(const char* name)
+{
+    fprintf(stderr,
+            "usage: %s [-q] replay...\n"
+            "       %s -w replay [-s seed] [-l level]\n"
+            "  -q         only print the summary\n"
+            "  -w replay  record a game with random directions\n"
+            "  -s seed    seed of the recorded game (default 1)\n"
+            "  -l level   level of the recorded game, below %d (default 0)\n",
+            name, name, LEVEL_COUNT);
+}
+
+/*************************************************
+**               public functions               **
+*************************************************/
+
+int main(int argc, char** argv)
+{
+    const char* recordPath = NULL;
+    uint16_t seed = 1;
+    unsigned level = 0;
+    int isQuiet = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "qw:s:l:")) != -1) {
+        switch (opt) {
+            case 'q': isQuiet = 1; break;
+            case 'w': recordPath = optarg; break;
+            case 's': seed = strtoul(optarg, NULL, 10); break;
+            case 'l': level = strtoul(optarg, NULL, 10); break;
+            default: PrintUsage(argv[0]); return 1;
+        }
+    }
+
+    if (level >= LEVEL_COUNT) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    if (recordPath) {
+        RecordRandomGame(level, seed);
+        if (SaveReplay(recordPath) != 0) {
+            fprintf(stderr, "cannot write %s\n", recordPath);
+            return 1;
+        }
+        printf("%s: %u ticks, score %u, %u bytes\n", recordPath,
+               (unsigned)replay.ticks, state.score, replay.size);
+        return 0;
+    }
+
+    if (optind >= argc) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    int failures = 0;
+    unsigned long ticks = 0;
+
+    for (int i = optind; i < argc; i++) {
+        const char* result =
+            LoadReplay(argv[i]) == 0 ? VerifyReplay() : "UNREADABLE";
+
+        if (result[0] != 'O') failures++;
+        ticks += replay.ticks;
+
+        if (!isQuiet || result[0] != 'O') printf("%s: %s\n", argv[i], result);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double seconds =
+        (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    int count = argc - optind;
+
+    printf("%d replays, %d failed, %lu ticks in %.3f s (%.0f replays/s)\n",
+           count, failures, ticks, seconds, count / seconds);
+
+    return failures ? 1 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,526 @@
+/**
+ * @file sim.c
+ * @author Raphael Jouretz (rjouretz.com)
+ * @brief Play large numbers of seeded games on every core and print
+ * aggregate statistics (JSON) to tune the difficulty rules
+ * @version 0.1
+ * @date 2023-06-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <resources/levels.h>
+#include <unistd.h>
+
+#include "autopilot.h"
+#include "engine.h"
+
+/** the number of seeds a worker takes from its range at once */
+#define DEFAULT_CHUNK 64
+
+/** the number of possible scores (the score is at most the snake length) */
+#define SCORE_COUNT (SNAKE_CAPACITY + 1)
+
+/** the number of buckets of the game length histogram (powers of two) */
+#define LENGTH_BUCKETS 32
+
+/*************************************************
+**                 structures                   **
+*************************************************/
+
+/** @struct SimStats
+ *  Represent the statistics of a set of games.
+ *
+ *  @var SimStats::games
+ *    The number of played games.
+ *  @var SimStats::scores
+ *    The score histogram.
+ *  @var SimStats::levels
+ *    The final level histogram.
+ *  @var SimStats::lengths
+ *    The game length histogram, bucket i counts the games of [2^i, 2^i+1[
+ *    ticks.
+ *  @var SimStats::ticks
+ *    The total number of ticks.
+ *  @var SimStats::maxTicks
+ *    The length of the longest game.
+ *  @var SimStats::heatmap
+ *    The number of moves of the head to every cell.
+ *  @var SimStats::lootDrops
+ *    The number of dropped loots.
+ *  @var SimStats::fullBoardDrops
+ *    The number of loot drops that found no empty cell.
+ *  @var SimStats::minFreeCells
+ *    The lowest number of empty cells a loot was drawn from.
+ *  @var SimStats::boardCells
+ *    The number of cells of the played level (width x height).
+ *  @var SimStats::wins
+ *    The number of games where the snake filled the board.
+ *  @var SimStats::timeouts
+ *    The number of games stopped after the maximum number of ticks.
+ */
+typedef struct {
+    uint64_t games;
+    uint64_t scores[SCORE_COUNT];
+    uint64_t levels[256];
+    uint64_t lengths[LENGTH_BUCKETS];
+    uint64_t ticks;
+    uint64_t maxTicks;
+    uint64_t heatmap[POSITION_COUNT];
+    uint64_t lootDrops;
+    uint64_t fullBoardDrops;
+    uint16_t minFreeCells;
+    uint16_t boardCells;
+    uint64_t wins;
+    uint64_t timeouts;
+} SimStats;
+
+/** @struct Worker
+ *  Represent a simulation thread with its own game state and its own range
+ *  of seeds. Other workers steal the second half of the range once theirs
+ *  is empty.
+ *
+ *  @var Worker::thread
+ *    The thread of the worker.
+ *  @var Worker::lock
+ *    Protect next and end.
+ *  @var Worker::next
+ *    The next seed to play.
+ *  @var Worker::end
+ *    The end of the seed range (excluded).
+ *  @var Worker::state
+ *    The game state of the worker.
+ *  @var Worker::autopilot
+ *    The search buffers of the autopilot of the worker.
+ *  @var Worker::stats
+ *    The statistics of the games played by the worker.
+ *  @var Worker::steals
+ *    The number of successful steals.
+ */
+typedef struct {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    uint64_t next;
+    uint64_t end;
+    EngineState state;
+    Autopilot autopilot;
+    SimStats stats;
+    uint64_t steals;
+} Worker;
+
+/*************************************************
+**               private variables              **
+*************************************************/
+
+Worker* workers;
+unsigned workerCount;
+uint64_t chunk = DEFAULT_CHUNK;
+uint64_t maxGameTicks = 1000000;
+int isAutopilot;
+unsigned level;
+
+/*************************************************
+**              private functions               **
+*************************************************/
+
+/**
+ * @brief Get the packed position next to the given one in the given
+ * direction.
+ *
+ * @param pos the packed position
+ * @param dir the direction (one of ENGINE_INPUTS)
+ * @return the next packed position
+ */
+uint16_t NextPosition(uint16_t pos, uint8_t dir)
+{
+    switch (dir) {
+        case INPUT_UP: return pos - BOARD_STRIDE;
+        case INPUT_DOWN: return pos + BOARD_STRIDE;
+        case INPUT_RIGHT: return pos + 1;
+        default: return pos - 1;
+    }
+}
+
+/**
+ * @brief Choose the input of a greedy player: the safe direction that gets
+ * closer to the last dropped loot.
+ *
+ * @param state the game state
+ * @return the input to give to StepEngine
+ */
+uint8_t GreedyInput(const EngineState* state)
+{
+    const uint8_t opposites[] = {0, INPUT_LEFT, INPUT_RIGHT, 0, INPUT_DOWN,
+                                 0, 0,          0,           INPUT_UP};
+    uint16_t head = state->snake.cells[state->snake.head];
+    int hasLoot = state->cells[state->lastLoot] == LOOT_CELL;
+    uint8_t bestDir = 0;
+    int bestDist = 1 << 30;
+
+    for (uint8_t dir = INPUT_RIGHT; dir <= INPUT_DOWN; dir <<= 1) {
+        if (dir == opposites[state->dir]) continue;
+
+        uint16_t pos = NextPosition(head, dir);
+        uint8_t cell = state->cells[pos];
+        if (cell == WALL_CELL || cell == SNAKE_CELL) continue;
+
+        int dist = 0;
+        if (hasLoot)
+            dist = abs(POSITION_X(pos) - POSITION_X(state->lastLoot)) +
+                   abs(POSITION_Y(pos) - POSITION_Y(state->lastLoot));
+
+        // without loot, keep the current direction if it is safe
+        if (dist < bestDist || (dist == bestDist && dir == state->dir)) {
+            bestDist = dist;
+            bestDir = dir;
+        }
+    }
+
+    return bestDir;
+}
+
+/**
+ * @brief Play the game of the given seed and add it to the statistics.
+ *
+ * @param state the game state to use
+ * @param autopilot the autopilot to use (with -a)
+ * @param stats the statistics to update
+ * @param seed the seed of the game
+ */
+void PlayGame(EngineState* state, Autopilot* autopilot, SimStats* stats,
+              uint64_t seed)
+{
+    InitEngine(state, levels[level], (uint16_t)seed, NULL);
+    ResetAutopilot(autopilot);
+    stats->boardCells = state->width * state->height;
+
+    uint64_t ticks = 0;
+    uint8_t input = 0;
+
+    while (!state->isOver && ticks < maxGameTicks) {
+        // the input is only read by the engine on the tick of a move
+        if (IS_MOVE_TICK(state))
+            input = isAutopilot ? NextAutopilotInput(autopilot, state)
+                                : GreedyInput(state);
+
+        uint16_t freeCells = state->freeCells.count;
+        int isDropTick = state->lootTimer == 1;
+        uint8_t events = StepEngine(state, input);
+        ticks++;
+
+        if (events & EVENT_MOVED) stats->heatmap[state->lastHead]++;
+        if (events & EVENT_LOOT) {
+            stats->lootDrops++;
+            if (freeCells < stats->minFreeCells)
+                stats->minFreeCells = freeCells;
+        }
+        else if (isDropTick && !state->isOver)
+            stats->fullBoardDrops++;
+        if (events & EVENT_WON) stats->wins++;
+    }
+
+    if (!state->isOver) stats->timeouts++;
+
+    uint8_t bucket = 0;
+    while (bucket < LENGTH_BUCKETS - 1 && (ticks >> (bucket + 1))) bucket++;
+
+    stats->games++;
+    stats->scores[state->score]++;
+    stats->levels[state->level]++;
+    stats->lengths[bucket]++;
+    stats->ticks += ticks;
+    if (ticks > stats->maxTicks) stats->maxTicks = ticks;
+}
+
+/**
+ * @brief Steal the second half of the seed range of the worker with the
+ * most remaining seeds.
+ *
+ * @param thief the worker stealing
+ * @return 1 if seeds were stolen, 0 if every range is empty
+ */
+int StealSeeds(Worker* thief)
+{
+    while (1) {
+        Worker* victim = NULL;
+        uint64_t mostSeeds = 0;
+
+        for (unsigned i = 0; i < workerCount; i++) {
+            if (&workers[i] == thief) continue;
+
+            pthread_mutex_lock(&workers[i].lock);
+            uint64_t seeds = workers[i].end - workers[i].next;
+            pthread_mutex_unlock(&workers[i].lock);
+
+            if (seeds > mostSeeds) {
+                mostSeeds = seeds;
+                victim = &workers[i];
+            }
+        }
+
+        if (!victim) return 0;
+
+        pthread_mutex_lock(&victim->lock);
+        uint64_t seeds = victim->end - victim->next;
+        uint64_t end = victim->end;
+        uint64_t start = end - (seeds + 1) / 2;
+        victim->end = start;
+        pthread_mutex_unlock(&victim->lock);
+
+        // the victim emptied its range in between, choose another one
+        if (seeds == 0) continue;
+
+        pthread_mutex_lock(&thief->lock);
+        thief->next = start;
+        thief->end = end;
+        pthread_mutex_unlock(&thief->lock);
+
+        thief->steals++;
+        return 1;
+    }
+}
+
+/**
+ * @brief Take the next seeds of the worker range.
+ *
+ * @param worker the worker
+ * @param first the first seed to play
+ * @param last the last seed to play (excluded)
+ * @return 1 if seeds were taken, 0 if the range is empty
+ */
+int TakeSeeds(Worker* worker, uint64_t* first, uint64_t* last)
+{
+    pthread_mutex_lock(&worker->lock);
+
+    int hasSeeds = worker->next < worker->end;
+    if (hasSeeds) {
+        *first = worker->next;
+        *last = worker->next + chunk;
+        if (*last > worker->end) *last = worker->end;
+        worker->next = *last;
+    }
+
+    pthread_mutex_unlock(&worker->lock);
+    return hasSeeds;
+}
+
+/**
+ * @brief The thread function of a worker
+ *
+ * @param arg the worker
+ * @return NULL
+ */
+void* RunWorker(void* arg)
+{
+    Worker* worker = arg;
+    uint64_t first, last;
+
+    while (TakeSeeds(worker, &first, &last) || (StealSeeds(worker) &&
+                                                TakeSeeds(worker, &first,
+                                                          &last))) {
+        for (uint64_t seed = first; seed < last; seed++)
+            PlayGame(&worker->state, &worker->autopilot, &worker->stats,
+                     seed);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Add the statistics of src to dst
+ *
+ * @param dst the statistics to update
+ * @param src the statistics to add
+ */
+void MergeStats(SimStats* dst, const SimStats* src)
+{
+    dst->games += src->games;
+    for (int i = 0; i < SCORE_COUNT; i++) dst->scores[i] += src->scores[i];
+    for (int i = 0; i < 256; i++) dst->levels[i] += src->levels[i];
+    for (int i = 0; i < LENGTH_BUCKETS; i++) dst->lengths[i] += src->lengths[i];
+    dst->ticks += src->ticks;
+    if (src->maxTicks > dst->maxTicks) dst->maxTicks = src->maxTicks;
+    for (int i = 0; i < POSITION_COUNT; i++) dst->heatmap[i] += src->heatmap[i];
+    dst->lootDrops += src->lootDrops;
+    dst->fullBoardDrops += src->fullBoardDrops;
+    if (src->minFreeCells < dst->minFreeCells)
+        dst->minFreeCells = src->minFreeCells;
+    if (src->boardCells > dst->boardCells) dst->boardCells = src->boardCells;
+    dst->wins += src->wins;
+    dst->timeouts += src->timeouts;
+}
+
+/**
+ * @brief Print a histogram as a JSON object of its non zero entries
+ *
+ * @param name the name of the histogram
+ * @param values the histogram
+ * @param count the number of entries of the histogram
+ */
+void PrintHistogram(const char* name, const uint64_t* values, int count)
+{
+    const char* separator = "";
+
+    printf("  \"%s\": {", name);
+    for (int i = 0; i < count; i++) {
+        if (!values[i]) continue;
+        printf("%s\"%d\": %llu", separator, i, (unsigned long long)values[i]);
+        separator = ", ";
+    }
+    printf("},\n");
+}
+
+/**
+ * @brief Print the statistics as JSON
+ *
+ * @param stats the statistics
+ * @param seconds the duration of the simulation
+ * @param steals the total number of steals
+ */
+void PrintStats(const SimStats* stats, double seconds, uint64_t steals)
+{
+    uint64_t totalScore = 0;
+    for (int i = 0; i < SCORE_COUNT; i++) totalScore += stats->scores[i] * i;
+
+    // with rejection sampling, a loot drop costs cells / free cells draws,
+    // the cells of the played level and not of the largest board
+    double worstAttempts =
+        stats->minFreeCells
+            ? (double)stats->boardCells / stats->minFreeCells
+            : 0.0;
+
+    printf("{\n");
+    printf("  \"threads\": %u,\n", workerCount);
+    printf("  \"games\": %llu,\n", (unsigned long long)stats->games);
+    printf("  \"seconds\": %.3f,\n", seconds);
+    printf("  \"games_per_second\": %.0f,\n", stats->games / seconds);
+    printf("  \"ticks_per_second\": %.0f,\n", stats->ticks / seconds);
+    printf("  \"steals\": %llu,\n", (unsigned long long)steals);
+    printf("  \"mean_score\": %.3f,\n",
+           stats->games ? (double)totalScore / stats->games : 0.0);
+    printf("  \"mean_ticks\": %.1f,\n",
+           stats->games ? (double)stats->ticks / stats->games : 0.0);
+    printf("  \"max_ticks\": %llu,\n", (unsigned long long)stats->maxTicks);
+    printf("  \"wins\": %llu,\n", (unsigned long long)stats->wins);
+    printf("  \"timeouts\": %llu,\n", (unsigned long long)stats->timeouts);
+    printf("  \"loot_drops\": %llu,\n", (unsigned long long)stats->lootDrops);
+    printf("  \"full_board_drops\": %llu,\n",
+           (unsigned long long)stats->fullBoardDrops);
+    printf("  \"min_free_cells_at_drop\": %u,\n", stats->minFreeCells);
+    printf("  \"worst_rejection_sampling_draws\": %.1f,\n", worstAttempts);
+    PrintHistogram("scores", stats->scores, SCORE_COUNT);
+    PrintHistogram("levels", stats->levels, 256);
+    PrintHistogram("ticks_log2", stats->lengths, LENGTH_BUCKETS);
+
+    printf("  \"heatmap\": [\n");
+    for (uint8_t y = 0; y < BOARD_HEIGHT; y++) {
+        printf("    [");
+        for (uint8_t x = 0; x < BOARD_WIDTH; x++)
+            printf("%s%llu", x ? ", " : "",
+                   (unsigned long long)stats->heatmap[PACK_POSITION(x, y)]);
+        printf("]%s\n", y + 1 < BOARD_HEIGHT ? "," : "");
+    }
+    printf("  ]\n}\n");
+}
+
+/**
+ * @brief Print the command usage
+ *
+ * @param name the name of the command
+ */
+void PrintUsage(const char* name)
+{
+    fprintf(stderr,
+            "usage: %s [-g games] [-s seed] [-j threads] [-c chunk] "
+            "[-m ticks] [-l level] [-a]\n"
+            "  -g games    number of games to play (default %u, every seed)\n"
+            "  -s seed     first seed, the seeds go up to %u (default 1)\n"
+            "  -j threads  number of threads (default: number of cores)\n"
+            "  -c chunk    seeds taken at once by a thread (default %d)\n"
+            "  -m ticks    maximum ticks of a game (default 1000000)\n"
+            "  -l level    index of the level, below %d (default 0)\n"
+            "  -a          play with the autopilot (default: greedy player)\n",
+            name, SEED_COUNT, SEED_COUNT, DEFAULT_CHUNK, LEVEL_COUNT);
+}
+
+/*************************************************
+**               public functions               **
+*************************************************/
+
+int main(int argc, char** argv)
+{
+    uint64_t games = SEED_COUNT;
+    uint64_t firstSeed = 1;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int opt;
+
+    workerCount = cores > 0 ? (unsigned)cores : 1;
+
+    while ((opt = getopt(argc, argv, "g:s:j:c:m:l:a")) != -1) {
+        switch (opt) {
+            case 'g': games = strtoull(optarg, NULL, 10); break;
+            case 's': firstSeed = strtoull(optarg, NULL, 10); break;
+            case 'j': workerCount = strtoul(optarg, NULL, 10); break;
+            case 'c': chunk = strtoull(optarg, NULL, 10); break;
+            case 'm': maxGameTicks = strtoull(optarg, NULL, 10); break;
+            case 'l': level = strtoul(optarg, NULL, 10); break;
+            case 'a': isAutopilot = 1; break;
+            default: PrintUsage(argv[0]); return 1;
+        }
+    }
+
+    // the engine has SEED_COUNT different games, a seed out of them would
+    // play one of them again
+    if (workerCount == 0 || chunk == 0 || level >= LEVEL_COUNT ||
+        firstSeed == 0 || firstSeed > SEED_COUNT ||
+        games > SEED_COUNT + 1 - firstSeed) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    workers = calloc(workerCount, sizeof(Worker));
+    if (!workers) return 1;
+
+    // split the seeds evenly, stealing balances the uneven game lengths
+    for (unsigned i = 0; i < workerCount; i++) {
+        pthread_mutex_init(&workers[i].lock, NULL);
+        workers[i].next = firstSeed + games * i / workerCount;
+        workers[i].end = firstSeed + games * (i + 1) / workerCount;
+        workers[i].stats.minFreeCells = UINT16_MAX;
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (unsigned i = 0; i < workerCount; i++)
+        pthread_create(&workers[i].thread, NULL, RunWorker, &workers[i]);
+
+    static SimStats stats;
+    uint64_t steals = 0;
+    stats.minFreeCells = UINT16_MAX;
+
+    for (unsigned i = 0; i < workerCount; i++) {
+        pthread_join(workers[i].thread, NULL);
+        MergeStats(&stats, &workers[i].stats);
+        steals += workers[i].steals;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (stats.minFreeCells == UINT16_MAX) stats.minFreeCells = 0;
+
+    double seconds =
+        (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    PrintStats(&stats, seconds, steals);
+
+    free(workers);
+    return 0;
+}
\ No newline at end of file
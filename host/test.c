@@ -0,0 +1,276 @@
+/**
+ * @file test.c
+ * @author Raphael Jouretz (rjouretz.com)
+ * @brief Check the game code on the host: every check prints its result and
+ * the command fails if one of them fails (see make test)
+ * @version 0.1
+ * @date 2023-06-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <resources/levels.h>
+#include <resources/sets.h>
+#include <resources/sets_packed.h>
+#include <resources/snake.h>
+#include <resources/snake_packed.h>
+#include <resources/snake_sleep.h>
+#include <resources/snake_sleep_packed.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "engine.h"
+#include "unpack.h"
+
+/** the number of bytes of a 2bpp tile */
+#define TILE_BYTES 16
+
+/** the number of seeds played on every level by the engine checks */
+#define ENGINE_SEEDS 8
+
+/** the number of ticks a random direction is held by the engine checks */
+#define RANDOM_HOLD_TICKS 24
+
+/** the largest unpacked table */
+#define MAX_TABLE_SIZE (sets_TILE_COUNT * TILE_BYTES)
+
+/*************************************************
+**                  structures                  **
+*************************************************/
+
+/** @struct PackedTable
+ *  Represent a table packed by scripts/pack.py and the png2asset table it
+ *  was packed from.
+ *
+ *  @var PackedTable::name
+ *    The name of the packed table.
+ *  @var PackedTable::packed
+ *    The packed table.
+ *  @var PackedTable::source
+ *    The png2asset table.
+ *  @var PackedTable::indices
+ *    The tiles of the source in the packed table (a tile set), or NULL if
+ *    the packed table is a part of the source from offset.
+ *  @var PackedTable::offset
+ *    The first byte of the source in the packed table.
+ *  @var PackedTable::size
+ *    The number of unpacked bytes (or tiles, for a tile set).
+ */
+typedef struct {
+    const char* name;
+    const uint8_t* packed;
+    const uint8_t* source;
+    const uint8_t* indices;
+    uint16_t offset;
+    uint16_t size;
+} PackedTable;
+
+/** @struct Check
+ *  Represent a check of the test.
+ *
+ *  @var Check::name
+ *    The name of the check.
+ *  @var Check::run
+ *    Run the check, return NULL on success or the reason of the failure.
+ */
+typedef struct {
+    const char* name;
+    const char* (*run)();
+} Check;
+
+/*************************************************
+**               private variables              **
+*************************************************/
+
+/** the map rows of a screen */
+#define SCREEN_TABLE(screen)                                                \
+    {#screen " map", sets_##screen##_map_packed, sets_map, NULL,             \
+     sets_##screen##_MAP_ROW * sets_MAP_WIDTH,                               \
+     sets_##screen##_MAP_HEIGHT * sets_MAP_WIDTH}
+
+/** a tile set of sets.bkg.png */
+#define TILESET_TABLE(set)                                                  \
+    {#set " tiles", sets_##set##_tiles_packed, sets_tiles,                   \
+     sets_##set##_tileset, 0, sets_##set##_TILESET_SIZE}
+
+/** every table packed by the Makefile */
+const PackedTable packedTables[] = {
+    TILESET_TABLE(menu),
+    TILESET_TABLE(board),
+    SCREEN_TABLE(menu),
+    SCREEN_TABLE(start_text),
+    SCREEN_TABLE(game_over),
+    {"snake tiles", snake_tiles_packed, snake_tiles, NULL, 0,
+     sizeof(snake_tiles)},
+    {"snake_sleep tiles", snake_sleep_tiles_packed, snake_sleep_tiles, NULL,
+     0, sizeof(snake_sleep_tiles)},
+};
+
+EngineState state;
+
+/** the failure of the last check, with its details */
+char reason[128];
+
+/*************************************************
+**              private functions               **
+*************************************************/
+
+/**
+ * @brief Unpack a table and compare it with its source.
+ *
+ * @param table a pointer to a PackedTable
+ * @return NULL if the table round trips, the reason otherwise
+ */
+const char* CheckPackedTable(const PackedTable* table)
+{
+    uint8_t unpacked[MAX_TABLE_SIZE];
+    uint8_t expected[MAX_TABLE_SIZE];
+    uint16_t size = table->size;
+
+    if (table->indices) {
+        for (uint16_t i = 0; i < table->size; i++)
+            memcpy(expected + i * TILE_BYTES,
+                   table->source + table->indices[i] * TILE_BYTES,
+                   TILE_BYTES);
+        size *= TILE_BYTES;
+    }
+    else
+        memcpy(expected, table->source + table->offset, size);
+
+    Unpacker unpacker;
+    StartUnpack(&unpacker, 0, table->packed);
+    Unpack(&unpacker, unpacked, size);
+
+    for (uint16_t i = 0; i < size; i++) {
+        if (unpacked[i] == expected[i]) continue;
+
+        snprintf(reason, sizeof(reason), "%s: byte %u is %u, not %u",
+                 table->name, i, unpacked[i], expected[i]);
+        return reason;
+    }
+
+    // the byte after the table must be the end of the stream
+    if (unpacker.length || *unpacker.packed) {
+        snprintf(reason, sizeof(reason), "%s: the stream is not over",
+                 table->name);
+        return reason;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Check that every table packed by scripts/pack.py unpacks to the
+ * png2asset table it was packed from.
+ *
+ * @return NULL on success, the reason of the failure otherwise
+ */
+const char* CheckPackedTables()
+{
+    for (uint8_t i = 0; i < sizeof(packedTables) / sizeof(packedTables[0]);
+         i++) {
+        const char* failure = CheckPackedTable(&packedTables[i]);
+        if (failure) return failure;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Check that the free cells of the state count the empty cells of
+ * every row.
+ *
+ * @return NULL on success, the reason of the failure otherwise
+ */
+const char* CheckFreeCellCounts()
+{
+    uint16_t count = 0;
+
+    for (uint8_t y = 0; y < BOARD_HEIGHT; y++) {
+        uint8_t rowCount = 0;
+
+        for (uint8_t x = 0; x < BOARD_STRIDE; x++)
+            if (state.cells[PACK_POSITION(x, y)] == EMPTY_CELL) rowCount++;
+
+        if (rowCount != state.freeCells.rowCounts[y]) {
+            snprintf(reason, sizeof(reason),
+                     "row %u has %u empty cells, counted %u", y, rowCount,
+                     state.freeCells.rowCounts[y]);
+            return reason;
+        }
+        count += rowCount;
+    }
+
+    if (count != state.freeCells.count) {
+        snprintf(reason, sizeof(reason), "%u empty cells, counted %u", count,
+                 state.freeCells.count);
+        return reason;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Check that the free cells follow the board during random games on
+ * every level.
+ *
+ * @return NULL on success, the reason of the failure otherwise
+ */
+const char* CheckFreeCells()
+{
+    for (uint8_t level = 0; level < LEVEL_COUNT; level++) {
+        for (uint16_t seed = 1; seed <= ENGINE_SEEDS; seed++) {
+            InitEngine(&state, levels[level], seed, NULL);
+            srand(seed);
+
+            uint8_t input = 0;
+
+            for (unsigned tick = 0; !state.isOver; tick++) {
+                // a random direction every RANDOM_HOLD_TICKS ticks
+                if (tick % RANDOM_HOLD_TICKS == 0) input = 1 << (rand() & 3);
+
+                StepEngine(&state, input);
+
+                const char* failure = CheckFreeCellCounts();
+                if (!failure) continue;
+
+                char details[sizeof(reason)];
+                snprintf(details, sizeof(details),
+                         "level %u, seed %u, tick %u: %s", level, seed, tick,
+                         failure);
+                strcpy(reason, details);
+                return reason;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/** every check, in the order they run */
+const Check checks[] = {
+    {"packed tables", CheckPackedTables},
+    {"free cells", CheckFreeCells},
+};
+
+/*************************************************
+**               public functions               **
+*************************************************/
+
+int main()
+{
+    int failures = 0;
+    uint8_t count = sizeof(checks) / sizeof(checks[0]);
+
+    for (uint8_t i = 0; i < count; i++) {
+        const char* failure = checks[i].run();
+
+        if (failure) failures++;
+        printf("%s: %s\n", checks[i].name, failure ? failure : "OK");
+    }
+
+    printf("%u checks, %d failed\n", count, failures);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,226 @@
+"""\
+This script compiles the text boards of resources/levels.txt to C sources.
+A level is a few bytes read by InitEngine (see LEVEL_FORMAT in
+src/engine.h):
+    the x and y of the snake, its direction (INPUT_*)
+    the level (speed) the snake starts at, the loot timer mask
+    the width and the height of the board
+    a 24 bits mask (LE) of the inner rows with walls, bit 0 for the row 1
+    the wall bits of every row of the mask, (width + 7) / 8 bytes (LE) with
+    the bit x for the column x
+The border is always a wall, so a board without inner walls is 10 bytes.
+
+A board is at least the size of the screen part that shows it (the camera
+scrolls over the larger ones) and at most BOARD_WIDTH x BOARD_HEIGHT (see
+src/engine.h).
+
+Usage: levels.py INPUT -o OUTPUT
+"""
+
+import os
+
+# the size of the screen part that shows the board (src/graphics.c)
+MIN_WIDTH = 20
+MIN_HEIGHT = 17
+
+# BOARD_WIDTH and BOARD_HEIGHT of src/engine.h
+MAX_WIDTH = 32
+MAX_HEIGHT = 20
+
+WALL = "#"
+EMPTY = "."
+
+# the INPUT_* value of every direction, and its move
+DIRECTIONS = {
+    ">": (0x01, (1, 0)),
+    "<": (0x02, (-1, 0)),
+    "^": (0x04, (0, -1)),
+    "v": (0x08, (0, 1)),
+}
+
+
+def read_levels(path: str) -> list:
+    """read the levels of a text file
+
+    Args:
+        path (str): the path of the text file
+
+    Returns:
+        list: the (speed, loot timer mask, name, rows) of every level
+    """
+    levels = []
+
+    # the comments start with "# " (or are a lone '#'), a row never does
+    with open(path) as source:
+        lines = [
+            line.rstrip("\n") for line in source
+            if line.strip() and not line.startswith("# ")
+            and line.strip() != "#"
+        ]
+
+    i = 0
+    while i < len(lines):
+        fields = lines[i].split(maxsplit=3)
+        if fields[0] != "level" or len(fields) < 3:
+            raise ValueError("expected a level line: %s" % lines[i])
+
+        # the rows go up to the next level line
+        end = i + 1
+        while end < len(lines) and not lines[end].startswith("level"):
+            end += 1
+
+        name = fields[3] if len(fields) > 3 else "level %d" % len(levels)
+        levels.append((int(fields[1]), int(fields[2]), name, lines[i + 1:end]))
+        i = end
+
+    return levels
+
+
+def check_level(name: str, rows: list) -> tuple:
+    """check a level and find the snake
+
+    Args:
+        name (str): the name of the level (for the errors)
+        rows (list): the rows of cells
+
+    Returns:
+        tuple: the x, y and direction (INPUT_*) of the snake
+    """
+    width = len(rows[0]) if rows else 0
+    height = len(rows)
+
+    if any(len(row) != width for row in rows):
+        raise ValueError("%s: the rows have different sizes" % name)
+    if not MIN_WIDTH <= width <= MAX_WIDTH or \
+            not MIN_HEIGHT <= height <= MAX_HEIGHT:
+        raise ValueError("%s: a board is from %dx%d to %dx%d cells" %
+                         (name, MIN_WIDTH, MIN_HEIGHT, MAX_WIDTH, MAX_HEIGHT))
+
+    snakes = [
+        (x, y) for y, row in enumerate(rows) for x, cell in enumerate(row)
+        if cell in DIRECTIONS
+    ]
+    if len(snakes) != 1:
+        raise ValueError("%s: a board has a single snake" % name)
+
+    for y, row in enumerate(rows):
+        for x, cell in enumerate(row):
+            is_border = x in (0, width - 1) or y in (0, height - 1)
+            if is_border and cell != WALL:
+                raise ValueError("%s: the border must be a wall" % name)
+            if cell not in (WALL, EMPTY) and cell not in DIRECTIONS:
+                raise ValueError("%s: unknown cell '%s'" % (name, cell))
+
+    x, y = snakes[0]
+    dir, (dx, dy) = DIRECTIONS[rows[y][x]]
+    if rows[y + dy][x + dx] != EMPTY:
+        raise ValueError("%s: the snake starts in front of a wall" % name)
+
+    # a loot can be dropped on any cell, so every cell must be reachable
+    seen = {(x, y)}
+    front = [(x, y)]
+    while front:
+        cx, cy = front.pop()
+        for nx, ny in ((cx + 1, cy), (cx - 1, cy), (cx, cy + 1), (cx, cy - 1)):
+            if rows[ny][nx] != WALL and (nx, ny) not in seen:
+                seen.add((nx, ny))
+                front.append((nx, ny))
+
+    free = sum(row.count(EMPTY) for row in rows) + 1
+    if len(seen) != free:
+        raise ValueError("%s: some cells cannot be reached" % name)
+
+    return x, y, dir
+
+
+def compile_level(speed: int, loot_mask: int, name: str, rows: list) -> list:
+    """compile a level to its bytes
+
+    Args:
+        speed (int): the level the snake starts at (from 1)
+        loot_mask (int): the loot timer mask
+        name (str): the name of the level
+        rows (list): the rows of cells
+
+    Returns:
+        list: the bytes of the level
+    """
+    x, y, dir = check_level(name, rows)
+    if not 1 <= speed <= 255 or not 0 <= loot_mask <= 255:
+        raise ValueError("%s: the speed and the loot mask are bytes" % name)
+
+    width, height = len(rows[0]), len(rows)
+    row_bytes = (width + 7) // 8
+    row_mask = 0
+    walls = []
+
+    for row_index in range(1, height - 1):
+        # the border columns are walls anyway
+        bits = sum(
+            1 << column for column, cell in enumerate(rows[row_index])
+            if cell == WALL and 0 < column < width - 1
+        )
+        if bits:
+            row_mask |= 1 << (row_index - 1)
+            walls.extend((bits >> (8 * i)) & 0xFF for i in range(row_bytes))
+
+    return [x, y, dir, speed, loot_mask, width, height, row_mask & 0xFF,
+            (row_mask >> 8) & 0xFF, row_mask >> 16] + walls
+
+
+def write_levels(input: str, output: str) -> None:
+    """write the compiled levels to 'output'.c and 'output'.h
+
+    Args:
+        input (str): the path of the text file
+        output (str): the path of the files, without extension
+    """
+    levels = read_levels(input)
+    bank = os.path.basename(output)
+
+    with open(output + ".h", "w") as header:
+        header.write("#ifndef LEVELS_H\n#define LEVELS_H\n")
+        header.write("#include <stdint.h>\n")
+        header.write("#include <gbdk/platform.h>\n")
+        header.write("BANKREF_EXTERN(%s)\n" % bank)
+        header.write("#define LEVEL_COUNT %d\n" % len(levels))
+        header.write("extern const uint8_t* const levels[LEVEL_COUNT];\n")
+        header.write("#endif\n")
+
+    with open(output + ".c", "w") as source:
+        source.write("#include <stdint.h>\n")
+        source.write("#include <gbdk/platform.h>\n")
+        source.write("BANKREF(%s)\n" % bank)
+
+        for i, (speed, loot_mask, name, rows) in enumerate(levels):
+            data = compile_level(speed, loot_mask, name, rows)
+            body = ", ".join("0x%02X" % value for value in data)
+            source.write("/* %s */\n" % name)
+            source.write("const uint8_t level%d[%d] = {%s};\n" %
+                         (i, len(data), body))
+
+        source.write("const uint8_t* const levels[%d] = {%s};\n" % (
+            len(levels), ", ".join("level%d" % i for i in range(len(levels)))))
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser(
+        description="compile the text boards of the game"
+    )
+    parser.add_argument(
+        "input",
+        type=str,
+        help="the text file of the levels",
+    )
+    parser.add_argument(
+        "-o",
+        "--output",
+        type=str,
+        required=True,
+        help="the path of the generated .c and .h files, without extension",
+    )
+
+    args = parser.parse_args()
+    write_levels(args.input, args.output)
@@ -0,0 +1,364 @@
+"""\
+This script packs the tiles and the map of a png2asset output as C sources,
+with a run length encoding made for 2bpp data. The game unpacks them while
+they are copied to VRAM (see src/unpack.h), so the ROM only holds the packed
+bytes. The tables can be placed in any ROM bank: the BANKREF of a file is its
+name (BANK(sets_packed) for sets_packed.c).
+
+A packed stream is a list of runs, each one starts with a byte: the 2 high
+bits are the kind of run and the 6 low bits its length (1 to 63).
+    LITERAL   (0x00): copy the next 'length' bytes
+    REPEAT    (0x40): repeat the next byte 'length' times
+    DOUBLE    (0x80): write each of the next 'length' bytes twice (a tile row
+                      whose 2 bit planes are equal: only colors 0 and 3)
+    INCREMENT (0xC0): write the next byte, then add 1 'length' - 1 times (the
+                      consecutive tile indices of a map)
+The byte 0x00 ends the stream.
+
+The map is packed by screens (blocks of full width rows), so a screen is
+unpacked without the rows above it.
+
+The tiles can be split in tile sets, the tiles a screen needs: a set is a
+list of screens (every tile their map uses) and tile ranges. For each set,
+the indices of its tiles in the png and the packed tiles, in the same order,
+are written instead of the whole tile table. The maps keep the png indices,
+the game loads the sets in free VRAM slots (see src/tiles.h), so all the sets
+must fit the TILE_SLOT_COUNT slots together.
+
+Usage: pack.py INPUT -o OUTPUT [--screen NAME:ROW:HEIGHT ...]
+                               [--tileset NAME:ITEM,ITEM... ...]
+"""
+
+import os
+import re
+
+LITERAL = 0x00
+REPEAT = 0x40
+DOUBLE = 0x80
+INCREMENT = 0xC0
+END = 0x00
+
+MAX_LENGTH = 0x3F
+
+TILE_SIZE = 8
+
+# the background tile slots of the game (TILE_SLOT_COUNT in src/tiles.h)
+TILE_SLOT_COUNT = 128
+
+
+def read_asset(path: str) -> tuple:
+    """read the tables and the size of a png2asset output
+
+    Args:
+        path (str): the path of the .c file (the .h file is next to it)
+
+    Returns:
+        tuple: the tiles, the map and the map width in tiles
+    """
+    name = os.path.splitext(os.path.basename(path))[0]
+
+    with open(path) as source:
+        tables = {
+            match.group(1): [int(v) for v in match.group(2).split(",")]
+            for match in re.finditer(
+                r"const (?:uint8_t|unsigned char) (\w+)\[\d+\] = \{([^}]*)\}",
+                source.read(),
+            )
+        }
+
+    with open(os.path.splitext(path)[0] + ".h") as header:
+        width = re.search(r"#define %s_WIDTH (\d+)" % name, header.read())
+
+    return (
+        tables[name + "_tiles"],
+        tables.get(name + "_map", []),
+        int(width.group(1)) // TILE_SIZE,
+    )
+
+
+def run_lengths(data: list, i: int) -> tuple:
+    """get the length of the runs starting at data[i]
+
+    Args:
+        data (list): the bytes to pack
+        i (int): the index of the first byte of the runs
+
+    Returns:
+        tuple: the length of the REPEAT, INCREMENT and DOUBLE runs, in bytes
+    """
+    count = len(data)
+
+    repeat = 1
+    while i + repeat < count and repeat < MAX_LENGTH and \
+            data[i + repeat] == data[i]:
+        repeat += 1
+
+    increment = 1
+    while i + increment < count and increment < MAX_LENGTH and \
+            data[i + increment] == (data[i] + increment) & 0xFF:
+        increment += 1
+
+    double = 0
+    while i + 2 * double + 1 < count and double < MAX_LENGTH and \
+            data[i + 2 * double] == data[i + 2 * double + 1]:
+        double += 1
+
+    return repeat, increment, 2 * double
+
+
+def pack(data: list) -> list:
+    """pack bytes. Runs shorter than 3 bytes (4 for DOUBLE) are kept as
+    literals, they would not save a byte.
+
+    Args:
+        data (list): the bytes to pack
+
+    Returns:
+        list: the packed stream
+    """
+    packed = []
+    literals = []
+
+    def flush_literals():
+        for start in range(0, len(literals), MAX_LENGTH):
+            chunk = literals[start:start + MAX_LENGTH]
+            packed.append(LITERAL | len(chunk))
+            packed.extend(chunk)
+        literals.clear()
+
+    i = 0
+    while i < len(data):
+        repeat, increment, double = run_lengths(data, i)
+
+        if repeat >= 3 and repeat >= increment and repeat >= double:
+            flush_literals()
+            packed.extend([REPEAT | repeat, data[i]])
+            i += repeat
+        elif increment >= 3 and increment >= double:
+            flush_literals()
+            packed.extend([INCREMENT | increment, data[i]])
+            i += increment
+        elif double >= 4:
+            flush_literals()
+            packed.append(DOUBLE | double // 2)
+            packed.extend(data[i:i + double:2])
+            i += double
+        else:
+            literals.append(data[i])
+            i += 1
+
+    flush_literals()
+    packed.append(END)
+    return packed
+
+
+def unpack(packed: list) -> list:
+    """unpack a stream (the reference of src/unpack.c)
+
+    Args:
+        packed (list): the packed stream
+
+    Returns:
+        list: the bytes
+    """
+    data = []
+    i = 0
+
+    while packed[i] != END:
+        kind, length = packed[i] & ~MAX_LENGTH, packed[i] & MAX_LENGTH
+        i += 1
+
+        if kind == LITERAL:
+            data.extend(packed[i:i + length])
+            i += length
+        elif kind == REPEAT:
+            data.extend([packed[i]] * length)
+            i += 1
+        elif kind == DOUBLE:
+            for value in packed[i:i + length]:
+                data.extend([value, value])
+            i += length
+        else:
+            data.extend((packed[i] + k) & 0xFF for k in range(length))
+            i += 1
+
+    return data
+
+
+def tileset_indices(items: list, screens: list, map: list, width: int,
+                    count: int) -> list:
+    """get the tiles of a tile set
+
+    Args:
+        items (list): the screen names and the tile ranges ("A" or "A-B") of
+            the set
+        screens (list): the (name, row, height) of the screens of the map
+        map (list): the map
+        width (int): the map width in tiles
+        count (int): the number of tiles
+
+    Returns:
+        list: the sorted indices of the tiles
+    """
+    rows = {screen: (row, height) for screen, row, height in screens}
+    indices = set()
+
+    for item in items:
+        if item in rows:
+            row, height = rows[item]
+            indices.update(map[row * width:(row + height) * width])
+        else:
+            first, _, last = item.partition("-")
+            indices.update(range(int(first), int(last or first) + 1))
+
+    if any(index >= count for index in indices):
+        raise ValueError("a tile set has a tile out of the %d tiles" % count)
+
+    return sorted(indices)
+
+
+def write_packed(input: str, output: str, screens: list,
+                 tilesets: list) -> None:
+    """write the packed tables of a png2asset output to 'output'.c and
+    'output'.h
+
+    Args:
+        input (str): the path of the png2asset .c file
+        output (str): the path of the files, without extension
+        screens (list): the (name, row, height) of the screens of the map
+        tilesets (list): the (name, items) of the tile sets
+    """
+    name = os.path.splitext(os.path.basename(input))[0]
+    bank = os.path.basename(output)
+    tiles, map, width = read_asset(input)
+    tile_bytes = 2 * TILE_SIZE
+    count = len(tiles) // tile_bytes
+
+    # the tile lists are written as they are, the other tables packed
+    indices = []
+    tables = [] if tilesets else [(name + "_tiles_packed", tiles)]
+    for tileset, items in tilesets:
+        set_indices = tileset_indices(items, screens, map, width, count)
+        indices.append((name, tileset, set_indices))
+        tables.append((
+            "%s_%s_tiles_packed" % (name, tileset),
+            [byte for index in set_indices
+             for byte in tiles[index * tile_bytes:(index + 1) * tile_bytes]],
+        ))
+
+    # the game acquires a set before it releases the previous one, so every
+    # set always has a slot for each of its tiles
+    set_tiles = sum(len(set_indices) for _, _, set_indices in indices)
+    if set_tiles > TILE_SLOT_COUNT:
+        raise ValueError("the tile sets have %d tiles, more than the %d slots"
+                         % (set_tiles, TILE_SLOT_COUNT))
+
+    for screen, row, height in screens:
+        tables.append((
+            "%s_%s_map_packed" % (name, screen),
+            map[row * width:(row + height) * width],
+        ))
+
+    with open(output + ".h", "w") as header:
+        guard = os.path.basename(output).upper() + "_H"
+        header.write("#ifndef %s\n#define %s\n" % (guard, guard))
+        header.write("#include <stdint.h>\n")
+        header.write("#include <gbdk/platform.h>\n")
+        header.write("BANKREF_EXTERN(%s)\n" % bank)
+        header.write("#define %s_TILE_COUNT %d\n" % (name, count))
+        header.write("#define %s_MAP_WIDTH %d\n" % (name, width))
+        for screen, row, height in screens:
+            header.write("#define %s_%s_MAP_ROW %d\n" % (name, screen, row))
+            header.write("#define %s_%s_MAP_HEIGHT %d\n" %
+                         (name, screen, height))
+        for _, tileset, data in indices:
+            header.write("#define %s_%s_TILESET_SIZE %d\n" %
+                         (name, tileset, len(data)))
+            header.write("extern const uint8_t %s_%s_tileset[%d];\n" %
+                         (name, tileset, len(data)))
+        for table, data in tables:
+            header.write("extern const uint8_t %s[%d];\n" %
+                         (table, len(pack(data))))
+        header.write("#endif\n")
+
+    with open(output + ".c", "w") as source:
+        source.write("#include <stdint.h>\n")
+        source.write("#include <gbdk/platform.h>\n")
+        source.write("BANKREF(%s)\n" % bank)
+        for _, tileset, data in indices:
+            body = ", ".join("%d" % value for value in data)
+            source.write("const uint8_t %s_%s_tileset[%d] = {%s};\n" %
+                         (name, tileset, len(data), body))
+        for table, data in tables:
+            packed = pack(data)
+            assert unpack(packed) == data
+
+            body = ", ".join("0x%02X" % value for value in packed)
+            source.write("/* %d bytes unpacked */\n" % len(data))
+            source.write("const uint8_t %s[%d] = {%s};\n" %
+                         (table, len(packed), body))
+
+
+def parse_screen(value: str) -> tuple:
+    """parse a NAME:ROW:HEIGHT screen argument
+
+    Args:
+        value (str): the argument
+
+    Returns:
+        tuple: the name, the first row and the number of rows of the screen
+    """
+    name, row, height = value.split(":")
+    return name, int(row), int(height)
+
+
+def parse_tileset(value: str) -> tuple:
+    """parse a NAME:ITEM,ITEM... tile set argument
+
+    Args:
+        value (str): the argument
+
+    Returns:
+        tuple: the name and the items (screen names and tile ranges) of the
+        set
+    """
+    name, items = value.split(":")
+    return name, items.split(",")
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser(
+        description="pack the tiles and the map screens of a png2asset output"
+    )
+    parser.add_argument(
+        "input",
+        type=str,
+        help="the .c file generated by png2asset",
+    )
+    parser.add_argument(
+        "-o",
+        "--output",
+        type=str,
+        required=True,
+        help="the path of the generated .c and .h files, without extension",
+    )
+    parser.add_argument(
+        "--screen",
+        type=parse_screen,
+        action="append",
+        default=[],
+        help="a screen of the map to pack, as NAME:ROW:HEIGHT (in tiles)",
+    )
+    parser.add_argument(
+        "--tileset",
+        type=parse_tileset,
+        action="append",
+        default=[],
+        help="a tile set to pack, as NAME:ITEM,ITEM... where an item is a "
+        "screen or a tile range (A or A-B)",
+    )
+
+    args = parser.parse_args()
+    write_packed(args.input, args.output, args.screen, args.tileset)
@@ -0,0 +1,146 @@
+"""\
+This script generates the palette tables of the game as C sources: the
+BGP_REG and OBP0_REG values of every fade step, of the flash effect and of
+the HUD band. The game only copies the values to the registers, so a fade
+step costs a table lookup.
+
+Usage: palettes.py [--steps STEPS] -o OUTPUT
+"""
+
+WHITE = 0
+LIGHT_GRAY = 1
+DARK_GRAY = 2
+BLACK = 3
+
+DEFAULT_BKG_PALETTE = (WHITE, LIGHT_GRAY, DARK_GRAY, BLACK)
+DEFAULT_SPRITE_PALETTE = (BLACK, LIGHT_GRAY, DARK_GRAY, WHITE)
+
+# the (background, sprite) palettes the flash effect picks from
+FLASH_PALETTES = [
+    ((BLACK, DARK_GRAY, BLACK, DARK_GRAY), (BLACK, DARK_GRAY, BLACK, DARK_GRAY)),
+    ((LIGHT_GRAY, WHITE, BLACK, DARK_GRAY), (BLACK, WHITE, DARK_GRAY, WHITE)),
+    ((BLACK, DARK_GRAY, BLACK, BLACK), (BLACK, DARK_GRAY, BLACK, LIGHT_GRAY)),
+    ((WHITE, LIGHT_GRAY, WHITE, LIGHT_GRAY), (BLACK, LIGHT_GRAY, WHITE, WHITE)),
+]
+
+# the legend band is drawn with the colors inverted
+HUD_BKG_PALETTE = (BLACK, DARK_GRAY, LIGHT_GRAY, WHITE)
+
+
+def to_register(palette: tuple) -> int:
+    """get the register value of a palette (the color of index i is stored
+    in the bits 2i and 2i+1)
+
+    Args:
+        palette (tuple): the 4 colors of the palette
+
+    Returns:
+        int: the register value
+    """
+    return sum(color << (2 * i) for i, color in enumerate(palette))
+
+
+def darken(palette: tuple, darkness: int, steps: int) -> tuple:
+    """darken a palette toward black. Every color moves to black by the same
+    ratio of its distance and is rounded to the closest of the 4 colors, so
+    the colors change at different steps.
+
+    Args:
+        palette (tuple): the 4 colors of the palette
+        darkness (int): the darkness, from 0 (the palette) to steps (black)
+        steps (int): the darkness of black
+
+    Returns:
+        tuple: the darkened palette
+    """
+    return tuple(
+        color + ((BLACK - color) * darkness * 2 + steps) // (steps * 2)
+        for color in palette
+    )
+
+
+def generate_fade_palettes(palette: tuple, steps: int) -> list:
+    """generate the register values of a fade from black (step 0) to the
+    given palette (last step)
+
+    Args:
+        palette (tuple): the 4 colors of the palette at full brightness
+        steps (int): the number of steps (at least 2)
+
+    Returns:
+        list: the register value of every step
+    """
+    last = steps - 1
+    return [
+        to_register(darken(palette, last - step, last)) for step in range(steps)
+    ]
+
+
+def format_table(name: str, values: list) -> str:
+    """format a const C table
+
+    Args:
+        name (str): the name of the table
+        values (list): the bytes of the table
+
+    Returns:
+        str: the C definition of the table
+    """
+    body = ", ".join("0x%02X" % value for value in values)
+    return "const uint8_t %s[%d] = {%s};\n" % (name, len(values), body)
+
+
+def write_palettes(output: str, steps: int) -> None:
+    """write the palette tables to 'output'.c and 'output'.h
+
+    Args:
+        output (str): the path of the files, without extension
+        steps (int): the number of fade steps
+    """
+    tables = [
+        ("fadeBkgPalettes", generate_fade_palettes(DEFAULT_BKG_PALETTE, steps)),
+        ("fadeSpritePalettes",
+         generate_fade_palettes(DEFAULT_SPRITE_PALETTE, steps)),
+        ("flashBkgPalettes", [to_register(p[0]) for p in FLASH_PALETTES]),
+        ("flashSpritePalettes", [to_register(p[1]) for p in FLASH_PALETTES]),
+    ]
+
+    with open(output + ".h", "w") as header:
+        header.write("#ifndef PALETTES_H\n#define PALETTES_H\n")
+        header.write("#include <stdint.h>\n")
+        header.write("#define FADE_STEP_COUNT %d\n" % steps)
+        header.write("#define FLASH_PALETTE_COUNT %d\n" % len(FLASH_PALETTES))
+        header.write("#define HUD_BKG_PALETTE 0x%02X\n" %
+                     to_register(HUD_BKG_PALETTE))
+        for name, values in tables:
+            header.write("extern const uint8_t %s[%d];\n" % (name, len(values)))
+        header.write("#endif\n")
+
+    with open(output + ".c", "w") as source:
+        source.write("#include <stdint.h>\n")
+        for name, values in tables:
+            source.write(format_table(name, values))
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser(
+        description="generate the palette register tables of the game"
+    )
+    parser.add_argument(
+        "--steps",
+        type=int,
+        default=13,
+        help="the number of fade steps (default 13)",
+    )
+    parser.add_argument(
+        "-o",
+        "--output",
+        type=str,
+        required=True,
+        help="the path of the generated .c and .h files, without extension",
+    )
+
+    args = parser.parse_args()
+    write_palettes(args.output, args.steps)
@@ -0,0 +1,765 @@
+#include "autopilot.h"
+
+/** the distance of a cell that cannot reach any loot */
+#define NO_DISTANCE 0xFFFF
+
+/** the area of a move that leaves enough room to the snake */
+#define SAFE_AREA 0xFFFF
+
+/** the loot timer of the plan, which never drops a loot */
+#define NO_LOOT_DROP 0xFFFF
+
+/** the bit of a packed position within its row mask */
+#define ROW_BIT(pos) ((uint32_t)1 << POSITION_X(pos))
+
+/*************************************************
+**                 structures                   **
+*************************************************/
+
+/** @struct MoveChoice
+ *  Represent a move the snake can take on the next tick.
+ *
+ *  @var MoveChoice::dir
+ *    The direction of the move.
+ *  @var MoveChoice::area
+ *    The area reachable after the move, or SAFE_AREA.
+ *  @var MoveChoice::tailDistance
+ *    The distance to the tail after the move, or NO_DISTANCE.
+ *  @var MoveChoice::lootDistance
+ *    The distance of the new head to the closest loot, or NO_DISTANCE.
+ */
+typedef struct {
+    uint8_t dir;
+    uint16_t area;
+    uint16_t tailDistance;
+    uint16_t lootDistance;
+} MoveChoice;
+
+/*************************************************
+**             private functions                **
+*************************************************/
+
+/**
+ * @brief Count the set bits of a row mask.
+ *
+ * @param bits the row mask
+ * @return the number of set bits
+ */
+uint8_t CountBits(uint32_t bits)
+{
+#ifdef __GNUC__
+    return __builtin_popcountl(bits);
+#else
+    uint8_t count = 0;
+
+    // every iteration clears the lowest set bit
+    while (bits) {
+        bits &= bits - 1;
+        count++;
+    }
+
+    return count;
+#endif
+}
+
+/**
+ * @brief Get the packed position next to another one.
+ *
+ * @param pos a packed position
+ * @param dir an INPUT_* direction
+ * @return the packed position next to pos in the direction
+ */
+uint16_t MovePosition(uint16_t pos, uint8_t dir)
+{
+    switch (dir) {
+        case INPUT_UP: return pos - BOARD_STRIDE;
+        case INPUT_DOWN: return pos + BOARD_STRIDE;
+        case INPUT_RIGHT: return pos + 1;
+        default: return pos - 1;
+    }
+}
+
+/**
+ * @brief Get a node of the snake from its tail.
+ *
+ * @param snake the snake
+ * @param index the index of the node from the tail (0 for the tail)
+ * @return the packed position of the node
+ */
+uint16_t SnakeNode(const Snake* snake, uint16_t index)
+{
+    index += snake->tail;
+    if (index >= SNAKE_CAPACITY) index -= SNAKE_CAPACITY;
+
+    return snake->cells[index];
+}
+
+/**
+ * @brief Get whether a cell is one of the first tail nodes of the snake,
+ * removed by the previous moves of a tick.
+ *
+ * @param snake the snake
+ * @param pos the packed position of the cell
+ * @param count the number of removed tail nodes
+ * @return non zero if the cell is a removed tail node
+ */
+uint8_t IsRemovedTail(const Snake* snake, uint16_t pos, uint8_t count)
+{
+    for (uint8_t i = 0; i < count; i++)
+        if (SnakeNode(snake, i) == pos) return 1;
+
+    return 0;
+}
+
+/**
+ * @brief Load the free and loot row masks from the board cells.
+ *
+ * @param autopilot a pointer to a valid Autopilot
+ * @param state the game state
+ */
+void LoadRows(Autopilot* autopilot, const EngineState* state)
+{
+    const uint8_t* cells = state->cells;
+
+    for (uint8_t y = 0; y < BOARD_HEIGHT; y++) {
+        uint32_t freeRow = 0;
+        uint32_t lootRow = 0;
+
+        // the cells right of the board are walls
+        for (uint8_t x = 0; x < state->width; x++) {
+            if (cells[x] == EMPTY_CELL) freeRow |= (uint32_t)1 << x;
+            if (cells[x] == LOOT_CELL) lootRow |= (uint32_t)1 << x;
+        }
+
+        autopilot->freeRows[y] = freeRow | lootRow;
+        autopilot->lootRows[y] = lootRow;
+        cells += BOARD_STRIDE;
+    }
+}
+
+/**
+ * @brief Move the front of a search by a number of cells in a straight line:
+ * the front becomes the cells reached through free cells only, in any
+ * direction, that were not visited yet. A single cell moves the front to its
+ * free neighbours. The cells a line goes through are the snake once it took
+ * the line, so they are visited too.
+ *
+ * @param autopilot a pointer to a valid Autopilot
+ * @param moves the number of cells of the line (1 or more)
+ * @return non zero if the new front is not empty
+ */
+uint8_t ExpandFront(Autopilot* autopilot, uint8_t moves)
+{
+    uint32_t* frontRows = autopilot->frontRows;
+    uint32_t* visitedRows = autopilot->visitedRows;
+    uint32_t openRows[BOARD_HEIGHT];
+    uint32_t nextRows[BOARD_HEIGHT];
+    uint32_t found = 0;
+
+    // a line never goes back through a visited cell (the snake cannot turn
+    // back over its body)
+    for (uint8_t y = 0; y < BOARD_HEIGHT; y++)
+        openRows[y] = autopilot->freeRows[y] & ~visitedRows[y];
+
+    for (uint8_t y = 0; y < BOARD_HEIGHT; y++) {
+        uint32_t right = frontRows[y];
+        uint32_t left = right;
+        uint32_t downOpen = 0xFFFFFFFF;
+        uint32_t upOpen = 0xFFFFFFFF;
+        uint32_t passed = 0;
+        uint32_t line = 0;
+
+        // the line of k cells ending at the row y starts at the row y - k
+        // (down) or y + k (up), every row after its start must be open
+        for (uint8_t k = 1; k <= moves; k++) {
+            right = right << 1 & openRows[y];
+            left = left >> 1 & openRows[y];
+            line = right | left;
+
+            if (k <= y) {
+                downOpen &= openRows[y - k + 1];
+                line |= frontRows[y - k] & downOpen;
+            }
+            if (y + k < BOARD_HEIGHT) {
+                upOpen &= openRows[y + k - 1];
+                line |= frontRows[y + k] & upOpen;
+            }
+
+            if (k < moves) passed |= line;
+        }
+
+        nextRows[y] = line;
+        visitedRows[y] |= passed;
+    }
+
+    for (uint8_t y = 0; y < BOARD_HEIGHT; y++) {
+        frontRows[y] = nextRows[y];
+        visitedRows[y] |= nextRows[y];
+        found |= nextRows[y];
+    }
+
+    return found != 0;
+}
+
+/**
+ * @brief Start a search from a single cell.
+ *
+ * @param autopilot a pointer to a valid Autopilot
+ * @param pos the packed position of the cell
+ */
+void StartSearch(Autopilot* autopilot, uint16_t pos)
+{
+    for (uint8_t y = 0; y < BOARD_HEIGHT; y++) {
+        autopilot->frontRows[y] = 0;
+        autopilot->visitedRows[y] = 0;
+    }
+
+    autopilot->frontRows[POSITION_Y(pos)] = ROW_BIT(pos);
+    autopilot->visitedRows[POSITION_Y(pos)] = ROW_BIT(pos);
+}
+
+/**
+ * @brief Count the free cells reachable from a cell (itself included).
+ *
+ * @param autopilot a pointer to a valid Autopilot
+ * @param pos the packed position of the cell
+ * @param limit the count from which the search can stop
+ * @return the number of reachable cells, at most limit (or 1)
+ */
+uint16_t FloodFill(Autopilot* autopilot, uint16_t pos, uint16_t limit)
+{
+    uint16_t count = 1;
+
+    StartSearch(autopilot, pos);
+
+    while (count < limit && ExpandFront(autopilot, 1)) {
+        for (uint8_t y = 0; y < BOARD_HEIGHT; y++)
+            count += CountBits(autopilot->frontRows[y]);
+    }
+
+    return count;
+}
+
+/**
+ * @brief Get the distance of cells to the closest loot, with a breadth
+ * first search starting from every loot at once.
+ *
+ * @param autopilot a pointer to a valid Autopilot
+ * @param positions the packed positions of the cells
+ * @param distances set to the distance of every cell, or NO_DISTANCE
+ * @param count the number of cells
+ */
+void LootDistances(Autopilot* autopilot, const uint16_t* positions,
+                   uint16_t* distances, uint8_t count)
+{
+    uint8_t left = count;
+
+    for (uint8_t i = 0; i < count; i++) distances[i] = NO_DISTANCE;
+
+    for (uint8_t y = 0; y < BOARD_HEIGHT; y++) {
+        autopilot->frontRows[y] = autopilot->lootRows[y];
+        autopilot->visitedRows[y] = autopilot->lootRows[y];
+    }
+
+    uint16_t distance = 0;
+
+    do {
+        for (uint8_t i = 0; i < count; i++) {
+            uint16_t pos = positions[i];
+
+            if (distances[i] == NO_DISTANCE &&
+                (autopilot->frontRows[POSITION_Y(pos)] & ROW_BIT(pos))) {
+                distances[i] = distance;
+                left--;
+            }
+        }
+
+        distance++;
+    } while (left && ExpandFront(autopilot, 1));
+}
+
+/**
+ * @brief Get the number of moves of the next tick that moves the snake.
+ *
+ * @param progress the move progress (see EngineState::moveProgress), set to
+ * the one after the tick
+ * @param speed the speed of the snake (more than 0)
+ * @return the number of moves of the tick (1 or more)
+ */
+uint8_t NextTickMoves(uint16_t* progress, uint16_t speed)
+{
+    uint16_t next = *progress;
+
+    do {
+        next += speed;
+    } while (next < 0x100);
+
+    *progress = next & 0xFF;
+    return next >> 8;
+}
+
+/**
+ * @brief Get the distance from the new head of a move to the cells the tail
+ * of the snake leaves, in ticks that move the snake. The search expands by
+ * the moves of every tick (a straight line above one cell per tick) and the
+ * snake nodes are freed as the tail leaves them, so a path to a freed cell
+ * lets the snake follow its tail. A cell is freed after the tick that leaves
+ * it (moving to the tail cell itself is a game over, the tail only leaves
+ * its cell after the move).
+ *
+ * @param autopilot a pointer to a valid Autopilot, whose free rows are the
+ * ones after the move. The freed nodes are set in the free rows.
+ * @param snake a pointer to the snake before the move
+ * @param pos the packed position of the new head
+ * @param removed the number of tail nodes the move removed
+ * @param progress the move progress after the move
+ * @param speed the speed of the snake
+ * @return the distance in ticks, or NO_DISTANCE if no freed cell is
+ * reachable
+ */
+uint16_t TailDistance(Autopilot* autopilot, const Snake* snake, uint16_t pos,
+                      uint16_t removed, uint16_t progress, uint16_t speed)
+{
+    uint32_t trailRows[BOARD_HEIGHT];
+    uint16_t distance = 0;
+
+    for (uint8_t y = 0; y < BOARD_HEIGHT; y++) trailRows[y] = 0;
+
+    StartSearch(autopilot, pos);
+
+    while (1) {
+        uint8_t moves = NextTickMoves(&progress, speed);
+        uint32_t found = 0;
+
+        distance++;
+        if (!ExpandFront(autopilot, moves)) return NO_DISTANCE;
+
+        for (uint8_t y = 0; y < BOARD_HEIGHT; y++)
+            found |= autopilot->frontRows[y] & trailRows[y];
+
+        if (found) return distance;
+
+        // the nodes the tail leaves during the tick
+        for (; moves && removed < snake->length; moves--, removed++) {
+            uint16_t node = SnakeNode(snake, removed);
+            autopilot->freeRows[POSITION_Y(node)] |= ROW_BIT(node);
+            trailRows[POSITION_Y(node)] |= ROW_BIT(node);
+        }
+    }
+}
+
+/**
+ * @brief Get where the next tick moves the head in a direction, and check
+ * that none of its moves ends the game.
+ *
+ * @param state the game state, on a tick that moves the snake
+ * @param dir the direction (not the opposite of the snake one)
+ * @param pos set to the packed position of the new head
+ * @param eaten set to the number of loots eaten by the tick
+ * @return non zero if the tick does not end the game
+ */
+uint8_t IsTickClear(const EngineState* state, uint8_t dir, uint16_t* pos,
+                    uint8_t* eaten)
+{
+    const Snake* snake = &state->snake;
+    uint16_t progress = state->moveProgress;
+    uint8_t moves = NextTickMoves(&progress, state->speed);
+
+    *pos = snake->cells[snake->head];
+    *eaten = 0;
+
+    // an other snake node is a game over (the tail included, it is only
+    // removed after the collision check), but the tail leaves its cell on
+    // every move the snake does not eat, so a later move of the tick can
+    // take it
+    for (uint8_t step = 0; step < moves; step++) {
+        *pos = MovePosition(*pos, dir);
+        uint8_t cell = state->cells[*pos];
+
+        if (cell == LOOT_CELL)
+            (*eaten)++;
+        else if (cell != EMPTY_CELL &&
+                 !IsRemovedTail(snake, *pos, step - *eaten))
+            return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Measure the room a move leaves to the snake: its reachable area
+ * and the distance to the cells its tail leaves.
+ *
+ * @param autopilot a pointer to a valid Autopilot
+ * @param state the game state, on a tick that moves the snake
+ * @param dir the direction, whose tick is clear (see IsTickClear)
+ * @param pos the packed position of the new head
+ * @param eaten the number of loots eaten by the tick
+ * @param area set to the reachable area, or SAFE_AREA if the snake fits
+ * @return the distance in ticks to the tail (see TailDistance)
+ */
+uint16_t MeasureRoom(Autopilot* autopilot, const EngineState* state,
+                     uint8_t dir, uint16_t pos, uint8_t eaten, uint16_t* area)
+{
+    const Snake* snake = &state->snake;
+    uint16_t progress = state->moveProgress;
+    uint8_t moves = NextTickMoves(&progress, state->speed);
+    uint16_t length = snake->length + eaten;
+    uint8_t removed = moves - eaten;
+
+    // the rows after the tick: the removed tails are free, the cells the
+    // head went through before the last one are the snake
+    LoadRows(autopilot, state);
+
+    for (uint8_t i = 0; i < removed; i++) {
+        uint16_t tail = SnakeNode(snake, i);
+        autopilot->freeRows[POSITION_Y(tail)] |= ROW_BIT(tail);
+    }
+
+    uint16_t body = snake->cells[snake->head];
+    for (uint8_t step = 1; step < moves; step++) {
+        body = MovePosition(body, dir);
+        autopilot->freeRows[POSITION_Y(body)] &= ~ROW_BIT(body);
+    }
+
+    // the new head is counted by the flood fill
+    *area = FloodFill(autopilot, pos, length + 1) - 1;
+    if (*area >= length) *area = SAFE_AREA;
+
+    // the tail is a node of the snake before the tick, unless the tick
+    // removed all of them (a snake of a single node is its own tail)
+    if (removed >= snake->length) return 0;
+
+    return TailDistance(autopilot, snake, pos, removed, progress,
+                        state->speed);
+}
+
+/**
+ * @brief Get the direction of the next tick toward the closest loot.
+ *
+ * @param autopilot a pointer to a valid Autopilot
+ * @param state the game state, on a tick that moves the snake
+ * @return the direction, or 0 if no clear tick leads to a loot
+ */
+uint8_t LootDirection(Autopilot* autopilot, const EngineState* state)
+{
+    uint8_t dirs[4];
+    uint16_t positions[4];
+    uint16_t distances[4];
+    uint8_t count = 0;
+
+    for (uint8_t dir = INPUT_RIGHT; dir <= INPUT_DOWN; dir <<= 1) {
+        uint8_t eaten;
+
+        if (dir == OPPOSITE_INPUT(state->dir)) continue;
+        if (!IsTickClear(state, dir, &positions[count], &eaten)) continue;
+
+        dirs[count++] = dir;
+    }
+
+    if (count == 0) return 0;
+
+    LoadRows(autopilot, state);
+    LootDistances(autopilot, positions, distances, count);
+
+    uint8_t best = 0;
+
+    for (uint8_t i = 1; i < count; i++) {
+        if (distances[i] < distances[best] ||
+            (distances[i] == distances[best] && dirs[i] == state->dir))
+            best = i;
+    }
+
+    return distances[best] == NO_DISTANCE ? 0 : dirs[best];
+}
+
+/**
+ * @brief Compare two moves without a safe plan: the safe move following the
+ * tail the longest way first, the tail frees a cell for every move so the
+ * snake waits for a safe loot. Without a safe move: the largest area, then
+ * the closest to a loot. Then the current direction.
+ *
+ * @param move the move to compare
+ * @param other the move to compare to
+ * @param dir the direction of the snake
+ * @return non zero if move is better than other
+ */
+uint8_t IsBetterMove(const MoveChoice* move, const MoveChoice* other,
+                     uint8_t dir)
+{
+    uint8_t isSafe = move->tailDistance != NO_DISTANCE;
+
+    if (isSafe != (other->tailDistance != NO_DISTANCE)) return isSafe;
+    if (isSafe && move->tailDistance != other->tailDistance)
+        return move->tailDistance > other->tailDistance;
+    if (!isSafe && move->area != other->area) return move->area > other->area;
+    if (!isSafe && move->lootDistance != other->lootDistance)
+        return move->lootDistance < other->lootDistance;
+
+    return move->dir == dir;
+}
+
+/**
+ * @brief Run a tick on the state of the plan, and the ticks that do not
+ * move the snake after it. No loot is dropped.
+ *
+ * @param plan the state of the plan
+ * @param dir the direction of the tick
+ */
+void StepPlan(EngineState* plan, uint8_t dir)
+{
+    do {
+        plan->lootTimer = NO_LOOT_DROP;
+        StepEngine(plan, dir);
+        dir = plan->dir;
+    } while (!plan->isOver && !IS_MOVE_TICK(plan));
+}
+
+/**
+ * @brief Get the moves of the next tick that do not end the game, from the
+ * best one (see IsBetterMove).
+ *
+ * @param autopilot a pointer to a valid Autopilot
+ * @param state the game state, on a tick that moves the snake
+ * @param moves set to the moves (3 at most), without their loot distance
+ * @param positions set to the new head of every move
+ * @return the number of moves
+ */
+uint8_t RankMoves(Autopilot* autopilot, const EngineState* state,
+                  MoveChoice* moves, uint16_t* positions)
+{
+    uint8_t count = 0;
+
+    // the snake cannot turn back
+    for (uint8_t dir = INPUT_RIGHT; dir <= INPUT_DOWN; dir <<= 1) {
+        MoveChoice* move = &moves[count];
+        uint8_t eaten;
+
+        if (dir == OPPOSITE_INPUT(state->dir)) continue;
+        if (!IsTickClear(state, dir, &positions[count], &eaten)) continue;
+
+        move->dir = dir;
+        move->tailDistance = MeasureRoom(autopilot, state, dir,
+                                         positions[count], eaten,
+                                         &move->area);
+        move->lootDistance = NO_DISTANCE;
+        count++;
+    }
+
+    for (uint8_t n = 0; n < count; n++) {
+        uint8_t best = n;
+
+        for (uint8_t i = n + 1; i < count; i++) {
+            if (IsBetterMove(&moves[i], &moves[best], state->dir)) best = i;
+        }
+
+        MoveChoice move = moves[best];
+        moves[best] = moves[n];
+        moves[n] = move;
+
+        uint16_t pos = positions[best];
+        positions[best] = positions[n];
+        positions[n] = pos;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Get whether the snake survives a number of ticks from a state: a
+ * depth first search over the safe moves of every tick (the best one first,
+ * see RankMoves), on copies of the state. The last state must still have a
+ * safe move. A tick whose moves are all unsafe is a dead end, so the search
+ * mostly follows a single line, and it gives up after LOOKAHEAD_NODES
+ * states.
+ *
+ * @param autopilot a pointer to a valid Autopilot
+ * @param state the game state, on a tick that moves the snake
+ * @param ticks the number of ticks to survive (at most LOOKAHEAD_TICKS)
+ * @return non zero if the snake survives
+ */
+uint8_t Survives(Autopilot* autopilot, const EngineState* state,
+                 uint8_t ticks)
+{
+    if (state->isOver) return state->snake.length == state->boardCellCount;
+    if (autopilot->lookaheadNodes == 0) return 0;
+    autopilot->lookaheadNodes--;
+
+    MoveChoice moves[3];
+    uint16_t positions[3];
+    uint8_t count = RankMoves(autopilot, state, moves, positions);
+
+    if (ticks == 0)
+        return count && moves[0].tailDistance != NO_DISTANCE;
+
+    EngineState* next = &autopilot->lookahead[ticks - 1];
+
+    for (uint8_t i = 0; i < count && moves[i].tailDistance != NO_DISTANCE;
+         i++) {
+        *next = *state;
+        StepPlan(next, moves[i].dir);
+
+        if (Survives(autopilot, next, ticks - 1)) return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Get whether the snake survives LOOKAHEAD_TICKS ticks after a
+ * move (see Survives).
+ *
+ * @param autopilot a pointer to a valid Autopilot
+ * @param state the game state, on a tick that moves the snake
+ * @param dir the direction of the move
+ * @return non zero if the snake survives
+ */
+uint8_t SurvivesMove(Autopilot* autopilot, const EngineState* state,
+                     uint8_t dir)
+{
+    EngineState* next = &autopilot->lookahead[LOOKAHEAD_TICKS - 1];
+
+    *next = *state;
+    StepPlan(next, dir);
+
+    autopilot->lookaheadNodes = LOOKAHEAD_NODES;
+    return Survives(autopilot, next, LOOKAHEAD_TICKS - 1);
+}
+
+/**
+ * @brief Plan the ticks toward the closest loot from a first direction, on
+ * a copy of the state, and check that the snake can still follow its tail
+ * once it ate the loot. The loot drops during the plan are not known, a
+ * drop cancels the plan (see NextAutopilotInput).
+ *
+ * @param autopilot a pointer to a valid Autopilot
+ * @param state the game state, on a tick that moves the snake
+ * @param dir the direction of the first tick
+ * @return non zero if the plan is safe
+ */
+uint8_t PlanLoot(Autopilot* autopilot, const EngineState* state, uint8_t dir)
+{
+    EngineState* plan = &autopilot->planState;
+    uint16_t score = state->score;
+
+    *plan = *state;
+    autopilot->planLength = 0;
+    autopilot->planIndex = 0;
+
+    do {
+        if (autopilot->planLength == PLAN_CAPACITY) return 0;
+
+        PlanStep* step = &autopilot->plan[autopilot->planLength++];
+        step->head = plan->snake.cells[plan->snake.head];
+        step->freeCount = plan->freeCells.count;
+        step->dir = dir;
+
+        StepPlan(plan, dir);
+
+        // a full board is won
+        if (plan->isOver) return plan->snake.length == plan->boardCellCount;
+        if (plan->score != score) break;
+
+        dir = LootDirection(autopilot, plan);
+    } while (dir);
+
+    if (!dir) return 0;
+
+    autopilot->lookaheadNodes = LOOKAHEAD_NODES;
+    return Survives(autopilot, plan, LOOKAHEAD_TICKS);
+}
+
+/*************************************************
+**               public functions               **
+*************************************************/
+
+void ResetAutopilot(Autopilot* autopilot)
+{
+    autopilot->planLength = 0;
+    autopilot->planIndex = 0;
+}
+
+uint8_t IsAutopilotMoveSafe(Autopilot* autopilot, const EngineState* state,
+                            uint8_t dir)
+{
+    uint16_t pos;
+    uint8_t eaten;
+
+    if (dir == OPPOSITE_INPUT(state->dir)) return 0;
+    if (!IsTickClear(state, dir, &pos, &eaten)) return 0;
+
+    return SurvivesMove(autopilot, state, dir);
+}
+
+uint8_t NextAutopilotInput(Autopilot* autopilot, const EngineState* state)
+{
+    // the engine only reads the input on the tick the snake moves
+    if (!IS_MOVE_TICK(state)) return state->dir;
+
+    const Snake* snake = &state->snake;
+    uint16_t head = snake->cells[snake->head];
+
+    // the plan is followed while the board is the planned one: a loot drop
+    // changes the free cells and a missed tick the head
+    if (autopilot->planIndex < autopilot->planLength) {
+        const PlanStep* step = &autopilot->plan[autopilot->planIndex];
+
+        if (step->head == head &&
+            step->freeCount == state->freeCells.count) {
+            autopilot->planIndex++;
+            return step->dir;
+        }
+    }
+
+    autopilot->planLength = 0;
+    autopilot->planIndex = 0;
+
+    MoveChoice moves[3];
+    uint16_t positions[3];
+    uint16_t distances[3];
+    uint8_t count = RankMoves(autopilot, state, moves, positions);
+
+    // every move is a game over
+    if (count == 0) return state->dir;
+
+    // the loots are searched on the board before the tick
+    LoadRows(autopilot, state);
+    LootDistances(autopilot, positions, distances, count);
+
+    for (uint8_t i = 0; i < count; i++) moves[i].lootDistance = distances[i];
+
+    // the safe moves toward a loot, the closest first: the first one whose
+    // plan lets the snake survive once it ate the loot is taken
+    uint8_t tried = 0;
+
+    while (1) {
+        uint8_t closest = count;
+
+        for (uint8_t i = 0; i < count; i++) {
+            if ((tried & moves[i].dir) ||
+                moves[i].tailDistance == NO_DISTANCE ||
+                moves[i].lootDistance == NO_DISTANCE)
+                continue;
+            if (closest == count ||
+                moves[i].lootDistance < moves[closest].lootDistance)
+                closest = i;
+        }
+
+        if (closest == count) break;
+        tried |= moves[closest].dir;
+
+        if (PlanLoot(autopilot, state, moves[closest].dir)) {
+            autopilot->planIndex = 1;
+            return moves[closest].dir;
+        }
+    }
+
+    autopilot->planLength = 0;
+
+    // no safe plan: the first move the snake survives, from the best one
+    for (uint8_t i = 0; i < count; i++) {
+        if (SurvivesMove(autopilot, state, moves[i].dir)) return moves[i].dir;
+    }
+
+    return moves[0].dir;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file autopilot.h
+ * @author Raphael Jouretz (rjouretz.com)
+ * @brief Play the snake automatically: path to the closest loot and avoid
+ * the moves that trap the snake (no gb/gb.h, so the host tools use it too)
+ * @version 0.1
+ * @date 2023-06-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * The board is held as one 32 bits mask per row (bit x for the column x), so
+ * a BFS step or a flood fill step expands a whole row with a few shifts.
+ */
+#include <stdint.h>
+
+#include "engine.h"
+
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+/** the maximum number of ticks of a plan */
+#define PLAN_CAPACITY 255
+
+/** the number of ticks a move is checked ahead */
+#ifndef LOOKAHEAD_TICKS
+#define LOOKAHEAD_TICKS 48
+#endif
+
+/** the number of states a lookahead visits before it gives up */
+#ifndef LOOKAHEAD_NODES
+#define LOOKAHEAD_NODES 1024
+#endif
+
+/** @struct PlanStep
+ *  Represent a tick of a plan, and the state it was planned on.
+ *
+ *  @var PlanStep::head
+ *    The packed position of the head before the tick.
+ *  @var PlanStep::freeCount
+ *    The number of empty cells before the tick.
+ *  @var PlanStep::dir
+ *    The direction of the tick.
+ */
+typedef struct {
+    uint16_t head;
+    uint16_t freeCount;
+    uint8_t dir;
+} PlanStep;
+
+/** @struct Autopilot
+ *  Represent the search buffers of the autopilot (one per thread).
+ *
+ *  @var Autopilot::freeRows
+ *    The cells the snake can move to (empty or loot).
+ *  @var Autopilot::lootRows
+ *    The loot cells.
+ *  @var Autopilot::frontRows
+ *    The cells found by the last expansion of a search.
+ *  @var Autopilot::visitedRows
+ *    The cells already found by a search.
+ *  @var Autopilot::planState
+ *    The copy of the game state the plan is played on.
+ *  @var Autopilot::plan
+ *    The ticks that move the snake to a loot.
+ *  @var Autopilot::planLength
+ *    The number of ticks of the plan.
+ *  @var Autopilot::planIndex
+ *    The next tick of the plan to play.
+ *  @var Autopilot::lookahead
+ *    The copies of the game state the ticks ahead are played on.
+ *  @var Autopilot::lookaheadNodes
+ *    The number of states the current lookahead can still visit.
+ */
+typedef struct {
+    uint32_t freeRows[BOARD_HEIGHT];
+    uint32_t lootRows[BOARD_HEIGHT];
+    uint32_t frontRows[BOARD_HEIGHT];
+    uint32_t visitedRows[BOARD_HEIGHT];
+    EngineState planState;
+    PlanStep plan[PLAN_CAPACITY];
+    uint8_t planLength;
+    uint8_t planIndex;
+    EngineState lookahead[LOOKAHEAD_TICKS];
+    uint16_t lookaheadNodes;
+} Autopilot;
+
+/**
+ * @brief Forget the plan of the last game. Must be called when a game
+ * starts.
+ *
+ * @param autopilot a pointer to an Autopilot
+ */
+void ResetAutopilot(Autopilot* autopilot);
+
+/**
+ * @brief Get whether the snake survives LOOKAHEAD_TICKS ticks after a move,
+ * as NextAutopilotInput checks its moves, so the host players can keep to
+ * the moves the autopilot would take.
+ *
+ * @param autopilot a pointer to an Autopilot
+ * @param state the game state, on a tick that moves the snake
+ * @param dir the direction of the move (an INPUT_* direction)
+ * @return non zero if the snake survives
+ */
+uint8_t IsAutopilotMoveSafe(Autopilot* autopilot, const EngineState* state,
+                            uint8_t dir);
+
+/**
+ * @brief Choose the input of the next tick. The direction is only chosen on
+ * the tick the snake moves, the other ticks keep the current direction.
+ *
+ * A move is safe if the snake can still reach a cell its tail leaves from
+ * the new head, as the tail frees a cell for every move. Above one cell per
+ * tick, a tick moves the snake several cells in the chosen direction, so the
+ * moves of the tick are checked and the search follows the moves of the
+ * next ticks. The safe moves toward a loot are planned up to the loot, on a
+ * copy of the state, and the plan is kept if the snake then survives
+ * LOOKAHEAD_TICKS more ticks: the plan is played until a loot drop changes
+ * the board. Without such a plan, the safe move with the longest way to the
+ * tail that survives LOOKAHEAD_TICKS ticks is chosen, and without a safe move
+ * the move with the most reachable cells. The copies of the state take
+ * about 90 KB, the autopilot is only built on the host.
+ *
+ * @param autopilot a pointer to an Autopilot
+ * @param state the game state
+ * @return the input to give to StepEngine (an INPUT_* direction)
+ */
+uint8_t NextAutopilotInput(Autopilot* autopilot, const EngineState* state);
+
+#endif
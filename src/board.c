@@ -1,245 +1,197 @@
 #include "board.h"
 
 #include <rand.h>
-#include <stdlib.h>
+#include <resources/levels.h>
 
+#ifdef AUTOPILOT
+#include "autopilot.h"
+#endif
+#include "engine.h"
 #include "graphics.h"
+#include "input.h"
+#include "replay.h"
 #include "sound.h"
 #include "utils.h"
 
 /*************************************************
-**                 structures                   **
+**               private variables              **
 *************************************************/
 
-/** @struct SnakeNode
- *  Represent a snake node with its position and a pointer to its direct child
- *  (the head being the root parent).
- *
- *  @var SnakeNode::x
- *    The x position of the node in the board.
- *  @var SnakeNode::y
- *    The y position of the node in the board.
- *  @var SnakeNode::next
- *    A pointer to the direct child of the node
- */
-struct SnakeNode {
-    uint8_t x, y;
-    struct SnakeNode* next;
-};
+/** statically allocated so the game never touches the heap */
+EngineState engine;
 
-typedef struct SnakeNode SnakeNode;
+/** the record of the last game, to reproduce it on the host (in WRAM) */
+Replay replay;
 
-/** @struct Snake
- *  Represent a snake with pointers to its head and tail
- *
- *  @var Snake::head
- *    A pointer to the head node of the snake (root parent node).
- *  @var Snake::tail
- *    A pointer to the tail node of the snake.
- */
-typedef struct {
-    SnakeNode* head;
-    SnakeNode* tail;
-} Snake;
+#ifdef AUTOPILOT
+/** the search buffers of the autopilot, only built on the host (see
+ * Makefile) */
+Autopilot autopilot;
+#endif
+
+/** the index of the level of the next game, the next one once it is
+ * cleared */
+uint8_t boardLevel;
+
+/** the brightness rises every 2 frames */
+const Keyframe boardFadeIn[] = {
+    KEYFRAME(ACTION_BRIGHTNESS, 0, 2),
+    REPEAT_KEYFRAME(ACTION_BRIGHTEN, 1, 2, BKG_BRIGHTNESS_MAX), END_KEYFRAME};
 
 /*************************************************
 **             private functions                **
 *************************************************/
 
 /**
- * @brief Initialize the given snake (already allocated).
- *
- * @param snake a pointer to a valid Snake.
- */
-void InitSnake(Snake* snake)
-{
-    snake->head = NULL;
-    snake->tail = NULL;
-}
-
-/**
- * @brief Prepend a new root node to the snake and set x and y positions to
- * this new node.
+ * @brief Print the given engine events to the screen.
  *
- * @param snake a pointer to a valid Snake
- * @param x the x position of the new node
- * @param y the y position of the new node
+ * @param events the events returned by StepEngine
+ * @param head the index of the snake head node before StepEngine
+ * @param tail the index of the snake tail node before StepEngine
  */
-void PrependSnakeNode(Snake* snake, uint8_t x, uint8_t y)
+void DrawEngineEvents(uint8_t events, uint16_t head, uint16_t tail)
 {
-    SnakeNode* newNode = (SnakeNode*)malloc(sizeof(SnakeNode));
-    newNode->x = x;
-    newNode->y = y;
-    newNode->next = snake->head;
-    snake->head = newNode;
-
-    // null tail means the snake has previously no node
-    if (snake->tail == NULL) snake->tail = newNode;
-}
+    const Snake* snake = &engine.snake;
+
+    // the snake can move several times per tick: the removed tail nodes are
+    // still in the ring buffer, between the old and the new tail. They are
+    // erased first, as a new head can take the cell of a removed tail.
+    if (events & EVENT_MOVED) {
+        while (tail != snake->tail) {
+            uint16_t pos = snake->cells[tail];
+            SetBoardCell(POSITION_X(pos), POSITION_Y(pos), EMPTY_CELL);
+            if (++tail == SNAKE_CAPACITY) tail = 0;
+        }
 
-/**
- * @brief Remove the tail node, prepend it as head node of the snake and
- * set x and y as new positions. This is a small optimisation to avoid
- * freeing the tail and allocating a new head.
- *
- * @param snake a pointer to a valid Snake
- * @param x the x position of the new head node
- * @param y the y position of the new head node
- */
-void PrependLastSnakeNode(Snake* snake, uint8_t x, uint8_t y)
-{
-    SnakeNode* prevNode = NULL;
-    SnakeNode* curNode = snake->head;
-    while (curNode->next != NULL) {
-        prevNode = curNode;
-        curNode = curNode->next;
-    }
-    // the last prev node is now the last node
-    if (prevNode) {
-        prevNode->next = NULL;
-        snake->tail = prevNode;
-        curNode->next = snake->head;
+        while (head != snake->head) {
+            if (++head == SNAKE_CAPACITY) head = 0;
+            uint16_t pos = snake->cells[head];
+            SetBoardCell(POSITION_X(pos), POSITION_Y(pos), SNAKE_CELL);
+        }
     }
 
-    curNode->x = x;
-    curNode->y = y;
-    snake->head = curNode;
-}
-
-/**
- * @brief Add a random loot to the play board.
- *
- */
-void AddRandomLootToBoard()
-{
-    while (TRUE) {
-        uint8_t x = rand() % MAX_TILE_WIDTH;
-        uint8_t y = rand() % MAX_TILE_HEIGHT - 1;
+    if (events & EVENT_GROWN) SetLegendScore(engine.score);
+    if (events & EVENT_LEVEL_UP) SetLegendLevel(engine.level);
 
-        BoardCell cell = GetBoardCell(x, y);
-        if (cell == EMPTY_CELL) {
-            SetBoardCell(x, y, LOOT_CELL);
-            break;
-        }
-    }
+    if (events & EVENT_LOOT)
+        SetBoardCell(POSITION_X(engine.lastLoot), POSITION_Y(engine.lastLoot),
+                     LOOT_CELL);
 }
 
 /*************************************************
 **               public functions               **
 *************************************************/
 
+uint8_t GetNextBoard()
+{
+    return boardLevel;
+}
+
+void SetNextBoard(uint8_t board)
+{
+    boardLevel = board;
+}
+
 void RunBoard()
 {
+    /****  init game  ****/
+
+    uint16_t seed = randw();
+
+    // the level is read from its bank, the engine builds the board screen
+    // while it builds the cells
+    uint8_t previousBank = CURRENT_BANK;
+    SWITCH_ROM(BANK(levels));
+    InitEngine(&engine, levels[boardLevel], seed, GetBoardBkgMap());
+    SWITCH_ROM(previousBank);
+
+    StartReplayRecord(&replay, boardLevel, seed);
+#ifdef AUTOPILOT
+    ResetAutopilot(&autopilot);
+#endif
+
     /****  prepare  ****/
 
-    ShowBoardBkg();
+    uint16_t spawn = engine.snake.cells[engine.snake.head];
+
+    ShowBoardBkg(engine.width, engine.height, POSITION_X(spawn),
+                 POSITION_Y(spawn));
     CollapseWin();
     ShowWin();
+    ShowHudBand();
     StopSound();
     HideSnakeSprite();
 
     /****  fade in  ****/
 
-    BOOLEAN isFadeIn = TRUE;
+    // the fade in starts once the board is copied
+    while (IsBkgPending()) Delay(1);
 
-    FadeState fadeState;
-    fadeState = CreateFadeState(6);
+    PlayTrack(PALETTE_TRACK, boardFadeIn);
 
-    while (isFadeIn) {
-        isFadeIn = UpdateFadeIn(&fadeState);
-        Delay(1);
-    }
+    while (UpdateTimeline()) Delay(1);
 
     /****  play sound  ****/
 
     PlayBoardSound(TRUE);
 
-    /****  init snake  ****/
+    SetLegendScore(engine.score);
+    SetLegendLevel(engine.level);
 
-    Snake snake;
-    InitSnake(&snake);
+    /****  game loop  ****/
 
-    uint8_t snakeDir = J_RIGHT;
-    uint8_t snakeTimer = 10;
-    uint16_t lootTimer = ((uint16_t)rand()) << 0;
-    uint8_t snakeSize = 1;
-    uint8_t level = 1;
+#ifdef AUTOPILOT
+    BOOLEAN isAutopilot = FALSE;
+#endif
+    uint8_t frames = 1;
 
-    SetLegendScore(snakeSize);
-    SetLegendLevel(level);
+    // forget the keys pressed before the game
+    TakePressedKeys();
 
-    // find the snake node from the board
-    for (uint8_t x = 0; x < MAX_TILE_WIDTH; x++) {
-        for (uint8_t y = 0; y < MAX_TILE_HEIGHT - 1; y++) {
-            BoardCell cell = GetBoardCell(x, y);
-            if (cell == SNAKE_CELL) PrependSnakeNode(&snake, x, y);
-        }
-    }
+    while (TRUE) {
+        // the engine queues the pressed directions as turns
+        uint8_t input = TakePressedKeys();
 
-    /****  game loop  ****/
+#ifdef AUTOPILOT
+        // SELECT toggles the autopilot, which replaces the directions
+        if (input & J_SELECT) isAutopilot = !isAutopilot;
+#endif
 
-    while (TRUE) {
-        // update the snake direction given the joypad input
-        // by rule, the cannot switch to opposite direction
-        if (joypad() & J_UP && snakeDir != J_DOWN) snakeDir = J_UP;
-        if (joypad() & J_DOWN && snakeDir != J_UP) snakeDir = J_DOWN;
-        if (joypad() & J_RIGHT && snakeDir != J_LEFT) snakeDir = J_RIGHT;
-        if (joypad() & J_LEFT && snakeDir != J_RIGHT) snakeDir = J_LEFT;
-
-        snakeTimer--;
-        if (snakeTimer == 0) {
-            // equation to lower the timer as the level increase
-            snakeTimer = 15 - (level * 2);
-
-            SnakeNode newHead;
-            newHead = *(snake.head);
-
-            // update the snake head position
-            switch (snakeDir) {
-                case J_UP: newHead.y--; break;
-                case J_DOWN: newHead.y++; break;
-                case J_RIGHT: newHead.x++; break;
-                case J_LEFT: newHead.x--; break;
-                default: break;
-            }
+        // run a tick for every frame since the last iteration, so the game
+        // keeps its speed when an iteration lags
+        for (; frames; frames--) {
+#ifdef AUTOPILOT
+            if (isAutopilot) input = NextAutopilotInput(&autopilot, &engine);
+#endif
 
-            // check game over
-            BoardCell cell = GetBoardCell(newHead.x, newHead.y);
+            uint16_t head = engine.snake.head;
+            uint16_t tail = engine.snake.tail;
 
-            if (cell == SNAKE_CELL || cell == WALL_CELL)
-                return;
+            RecordReplayInput(&replay, input);
+            uint8_t events = StepEngine(&engine, input);
 
-            else if (cell == LOOT_CELL) {
-                PrependSnakeNode(&snake, newHead.x, newHead.y);
+            DrawEngineEvents(events, head, tail);
 
-                snakeSize++;
-                SetLegendScore(snakeSize);
+            if (engine.isOver) {
+                FinishReplayRecord(&replay, &engine);
 
-                // each the the snake grow by 5, the level up
-                if (snakeSize % 5 == 0) {
-                    level++;
-                    SetLegendLevel(level);
-                }
+                // a won game clears the board, the next game is on the
+                // next one
+                if ((events & EVENT_WON) && ++boardLevel == LEVEL_COUNT)
+                    boardLevel = 0;
+                return;
             }
-            else {
-                // erase the last snake position
-                SetBoardCell(snake.tail->x, snake.tail->y, EMPTY_CELL);
 
-                PrependLastSnakeNode(&snake, newHead.x, newHead.y);
-            }
+            UpdateSound();
 
-            // print the snake
-            SetBoardCell(snake.head->x, snake.head->y, SNAKE_CELL);
+            // the pressed keys are given to the first tick only
+            input = 0;
         }
 
-        lootTimer--;
-        if (lootTimer == 0) {
-            lootTimer = ((uint16_t)rand()) << 0;
+        // the camera follows the head on the boards larger than the screen
+        uint16_t pos = engine.snake.cells[engine.snake.head];
+        FollowBoardCamera(POSITION_X(pos), POSITION_Y(pos));
 
-            AddRandomLootToBoard();
-        }
-
-        Delay(1);
-        UpdateSound();
+        frames = WaitFrame();
     }
-}
+}
\ No newline at end of file
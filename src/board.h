@@ -11,10 +11,26 @@
 #ifndef BOARD_H
 #define BOARD_H
 
+#include <stdint.h>
+
 /**
  * @brief Run the loop of the actual game screen (snake grid)
  *
  */
 void RunBoard();
 
+/**
+ * @brief Get the board the next game is played on.
+ *
+ * @return the index of the board within the levels
+ */
+uint8_t GetNextBoard();
+
+/**
+ * @brief Set the board the next game is played on.
+ *
+ * @param board the index of the board, below LEVEL_COUNT
+ */
+void SetNextBoard(uint8_t board);
+
 #endif
\ No newline at end of file
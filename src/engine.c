@@ -0,0 +1,419 @@
+#include "engine.h"
+
+/** the number of levels with their own speed */
+#define SPEED_COUNT (sizeof(snakeSpeeds) / sizeof(snakeSpeeds[0]))
+
+/*************************************************
+**               private variables              **
+*************************************************/
+
+/** the speed of every level, in ROM */
+const uint16_t snakeSpeeds[] = SNAKE_SPEEDS;
+
+/*************************************************
+**             private functions                **
+*************************************************/
+
+/**
+ * @brief Get the next number of the random number generator (xorshift).
+ *
+ * @param state a pointer to a valid EngineState
+ * @return the next random number
+ */
+uint16_t NextRandom(EngineState* state)
+{
+    uint16_t x = state->random;
+
+    x ^= x << 7;
+    x ^= x >> 9;
+    x ^= x << 8;
+
+    state->random = x;
+    return x;
+}
+
+/**
+ * @brief Initialize the given snake with no node.
+ *
+ * @param snake a pointer to a valid Snake.
+ */
+void InitSnake(Snake* snake)
+{
+    // the first pushed node is stored at index 0 and is both head and tail
+    snake->head = SNAKE_CAPACITY - 1;
+    snake->tail = 0;
+    snake->length = 0;
+}
+
+/**
+ * @brief Push a new head node to the snake at the given packed position.
+ *
+ * @param snake a pointer to a valid Snake
+ * @param pos the packed position of the new head node
+ */
+void PushSnakeHead(Snake* snake, uint16_t pos)
+{
+    snake->head++;
+    if (snake->head == SNAKE_CAPACITY) snake->head = 0;
+
+    snake->cells[snake->head] = pos;
+    snake->length++;
+}
+
+/**
+ * @brief Remove the tail node of the snake.
+ *
+ * @param snake a pointer to a valid Snake with at least one node
+ * @return the packed position of the removed tail node
+ */
+uint16_t PopSnakeTail(Snake* snake)
+{
+    uint16_t pos = snake->cells[snake->tail];
+
+    snake->tail++;
+    if (snake->tail == SNAKE_CAPACITY) snake->tail = 0;
+
+    snake->length--;
+    return pos;
+}
+
+/**
+ * @brief Initialize the given set with no cell.
+ *
+ * @param freeCells a pointer to a valid FreeCells.
+ */
+void InitFreeCells(FreeCells* freeCells)
+{
+    for (uint8_t y = 0; y < BOARD_HEIGHT; y++) freeCells->rowCounts[y] = 0;
+    freeCells->count = 0;
+}
+
+/**
+ * @brief Add the cell at the given packed position to the set.
+ *
+ * @param freeCells a pointer to a valid FreeCells
+ * @param pos the packed position of a cell that is not in the set
+ */
+void AddFreeCell(FreeCells* freeCells, uint16_t pos)
+{
+    freeCells->rowCounts[POSITION_Y(pos)]++;
+    freeCells->count++;
+}
+
+/**
+ * @brief Remove the cell at the given packed position from the set.
+ *
+ * @param freeCells a pointer to a valid FreeCells
+ * @param pos the packed position of a cell that is in the set
+ */
+void RemoveFreeCell(FreeCells* freeCells, uint16_t pos)
+{
+    freeCells->rowCounts[POSITION_Y(pos)]--;
+    freeCells->count--;
+}
+
+/**
+ * @brief Get a new random value for the loot timer.
+ *
+ * @param state a pointer to a valid EngineState
+ * @return the number of ticks before the next loot drop
+ */
+uint16_t NextLootTimer(EngineState* state)
+{
+    return 1 + (NextRandom(state) & state->lootTimerMask);
+}
+
+/**
+ * @brief Add a loot to a random empty cell of the board.
+ *
+ * @param state a pointer to a valid EngineState
+ * @return EVENT_LOOT if the loot was added. 0 if the board is full.
+ */
+uint8_t AddRandomLoot(EngineState* state)
+{
+    FreeCells* freeCells = &state->freeCells;
+
+    if (freeCells->count == 0) return 0;
+
+    // the smallest mask of low bits that covers every empty cell
+    uint16_t mask = freeCells->count - 1;
+    mask |= mask >> 1;
+    mask |= mask >> 2;
+    mask |= mask >> 4;
+    mask |= mask >> 8;
+
+    // the n-th empty cell is drawn under the mask until it exists, which
+    // takes less than 2 draws on average and no divide (a software one on
+    // the gameboy)
+    uint16_t n;
+    do {
+        n = NextRandom(state) & mask;
+    } while (n >= freeCells->count);
+
+    // its row from the row counts (a row at a time), then in the row (a
+    // cell at a time)
+    uint8_t y = 0;
+
+    for (; n >= freeCells->rowCounts[y]; y++) n -= freeCells->rowCounts[y];
+
+    uint16_t pos = PACK_POSITION(0, y);
+
+    while (state->cells[pos] != EMPTY_CELL || n) {
+        if (state->cells[pos] == EMPTY_CELL) n--;
+        pos++;
+    }
+
+    RemoveFreeCell(freeCells, pos);
+
+    state->cells[pos] = LOOT_CELL;
+    state->lastLoot = pos;
+    return EVENT_LOOT;
+}
+
+/**
+ * @brief Get the tile of a wall on the board screen.
+ *
+ * @param state the game state, whose board size is set
+ * @param x the x position of the wall
+ * @param y the y position of the wall
+ * @return the tile (one of WALL_TILES)
+ */
+uint8_t WallTile(const EngineState* state, uint8_t x, uint8_t y)
+{
+    uint8_t right = state->width - 1;
+
+    if (x > right || y >= state->height) return BLOCK_TILE;
+
+    if (y == 0)
+        return x == 0       ? TOP_LEFT_WALL_TILE
+               : x == right ? TOP_RIGHT_WALL_TILE
+                            : TOP_WALL_TILE;
+    if (y == state->height - 1)
+        return x == 0       ? BOTTOM_LEFT_WALL_TILE
+               : x == right ? BOTTOM_RIGHT_WALL_TILE
+                            : BOTTOM_WALL_TILE;
+    if (x == 0) return LEFT_WALL_TILE;
+    if (x == right) return RIGHT_WALL_TILE;
+
+    return BLOCK_TILE;
+}
+
+/**
+ * @brief Get the speed of the snake at a level.
+ *
+ * @param level the level (from 1)
+ * @return the speed in 1/256 cells per tick
+ */
+uint16_t LevelSpeed(uint8_t level)
+{
+    return snakeSpeeds[level < SPEED_COUNT ? level - 1 : SPEED_COUNT - 1];
+}
+
+/**
+ * @brief Queue a turn for the next moves. By rule, the snake cannot turn
+ * back, so the turn is checked against the last queued one.
+ *
+ * @param state a pointer to a valid EngineState
+ * @param dir the direction of the turn (one of ENGINE_INPUTS)
+ */
+void QueueTurn(EngineState* state, uint8_t dir)
+{
+    uint8_t last = state->turnCount ? state->turns[state->turnCount - 1]
+                                    : state->dir;
+
+    if (dir == last || dir == OPPOSITE_INPUT(last)) return;
+    if (state->turnCount == TURN_QUEUE_SIZE) return;
+
+    state->turns[state->turnCount++] = dir;
+}
+
+/**
+ * @brief Remove the first queued turn.
+ *
+ * @param state a pointer to a valid EngineState with at least one turn
+ * @return the direction of the removed turn
+ */
+uint8_t PopTurn(EngineState* state)
+{
+    uint8_t dir = state->turns[0];
+
+    state->turnCount--;
+    for (uint8_t i = 0; i < state->turnCount; i++)
+        state->turns[i] = state->turns[i + 1];
+
+    return dir;
+}
+
+/**
+ * @brief Move the snake one cell forward in its direction.
+ *
+ * @param state a pointer to a valid EngineState
+ * @return the events of the move
+ */
+uint8_t MoveSnake(EngineState* state)
+{
+    Snake* snake = &state->snake;
+    uint16_t pos = snake->cells[snake->head];
+
+    // the board is surrounded by walls, so the head never leaves the board
+    switch (state->dir) {
+        case INPUT_UP: pos -= BOARD_STRIDE; break;
+        case INPUT_DOWN: pos += BOARD_STRIDE; break;
+        case INPUT_RIGHT: pos++; break;
+        case INPUT_LEFT: pos--; break;
+        default: break;
+    }
+
+    uint8_t cell = state->cells[pos];
+    uint8_t events = EVENT_MOVED;
+
+    // check game over
+    if (cell == SNAKE_CELL || cell == WALL_CELL) {
+        state->isOver = 1;
+        return EVENT_GAME_OVER;
+    }
+    else if (cell == LOOT_CELL) {
+        events |= EVENT_GROWN;
+        state->score++;
+
+        // each time the snake grows by LEVEL_UP_SCORE, the level up. A
+        // counter avoids a modulo on every loot.
+        state->lootsToLevelUp--;
+        if (state->lootsToLevelUp == 0) {
+            state->lootsToLevelUp = LEVEL_UP_SCORE;
+            state->level++;
+            state->speed = LevelSpeed(state->level);
+            events |= EVENT_LEVEL_UP;
+        }
+    }
+    else {
+        // erase the last snake position
+        uint16_t tail = PopSnakeTail(snake);
+        AddFreeCell(&state->freeCells, tail);
+        state->cells[tail] = EMPTY_CELL;
+        state->lastTail = tail;
+
+        // a loot cell was already removed when the loot was added
+        RemoveFreeCell(&state->freeCells, pos);
+    }
+
+    PushSnakeHead(snake, pos);
+    state->cells[pos] = SNAKE_CELL;
+    state->lastHead = pos;
+
+    // board full: nothing is left to eat, the game is won
+    if (snake->length == state->boardCellCount) {
+        state->isOver = 1;
+        events |= EVENT_WON;
+    }
+
+    return events;
+}
+
+/*************************************************
+**               public functions               **
+*************************************************/
+
+void InitEngine(EngineState* state, const uint8_t* level, uint16_t seed,
+                uint8_t* tiles)
+{
+    InitSnake(&state->snake);
+    InitFreeCells(&state->freeCells);
+
+    // xorshift never leaves 0, any other value is a valid state
+    state->random = seed ? seed : 0xACE1;
+
+    uint16_t snakePos =
+        PACK_POSITION(level[LEVEL_SNAKE_X], level[LEVEL_SNAKE_Y]);
+    uint32_t rowMask = level[LEVEL_ROWS] |
+                       ((uint16_t)level[LEVEL_ROWS + 1] << 8) |
+                       ((uint32_t)level[LEVEL_ROWS + 2] << 16);
+    const uint8_t* walls = level + LEVEL_WALLS;
+
+    state->width = level[LEVEL_WIDTH];
+    state->height = level[LEVEL_HEIGHT];
+
+    // the border and the cells around the board are walls
+    uint32_t innerRow = ~(((uint32_t)1 << (state->width - 1)) - 2);
+    uint8_t rowBytes = (state->width + 7) >> 3;
+
+    // a single pass sets the cells and the tiles, row by row
+    uint16_t pos = 0;
+
+    for (uint8_t y = 0; y < BOARD_HEIGHT; y++) {
+        uint32_t row = 0xFFFFFFFF;
+
+        if (y != 0 && y < state->height - 1) {
+            row = innerRow;
+
+            if (rowMask & 1) {
+                for (uint8_t i = 0; i < rowBytes; i++)
+                    row |= (uint32_t)*walls++ << (i << 3);
+            }
+            rowMask >>= 1;
+        }
+
+        for (uint8_t x = 0; x < BOARD_STRIDE; x++, row >>= 1) {
+            uint8_t cell = (row & 1) ? WALL_CELL : EMPTY_CELL;
+
+            if (pos == snakePos) {
+                cell = SNAKE_CELL;
+                PushSnakeHead(&state->snake, pos);
+            }
+            else if (cell == EMPTY_CELL)
+                AddFreeCell(&state->freeCells, pos);
+
+            state->cells[pos] = cell;
+
+            if (tiles)
+                *tiles++ = cell == WALL_CELL ? WallTile(state, x, y) : cell;
+
+            pos++;
+        }
+    }
+
+    // the snake wins once it covers every cell that is not a wall
+    state->boardCellCount = state->freeCells.count + state->snake.length;
+
+    state->dir = level[LEVEL_DIR];
+    state->turnCount = 0;
+    state->moveProgress = 0;
+    state->lootTimerMask = level[LEVEL_LOOT_MASK] & LOOT_TIMER_MASK;
+    state->lootTimer = NextLootTimer(state);
+    state->score = 1;
+    state->level = level[LEVEL_SPEED];
+    state->speed = LevelSpeed(state->level);
+    // the score starts at 1, the first level up is at LEVEL_UP_SCORE
+    state->lootsToLevelUp = LEVEL_UP_SCORE - 1;
+    state->isOver = 0;
+}
+
+uint8_t StepEngine(EngineState* state, uint8_t input)
+{
+    if (state->isOver) return 0;
+
+    uint8_t events = 0;
+
+    for (uint8_t dir = INPUT_RIGHT; dir <= INPUT_DOWN; dir <<= 1)
+        if (input & dir) QueueTurn(state, dir);
+
+    // the snake moves once for every whole cell of progress, so the speed
+    // has a sub tick precision and can exceed one cell per tick
+    state->moveProgress += state->speed;
+    while (state->moveProgress >= 0x100) {
+        state->moveProgress -= 0x100;
+
+        if (state->turnCount) state->dir = PopTurn(state);
+
+        events |= MoveSnake(state);
+        if (state->isOver) return events;
+    }
+
+    state->lootTimer--;
+    if (state->lootTimer == 0) {
+        state->lootTimer = NextLootTimer(state);
+        events |= AddRandomLoot(state);
+    }
+
+    return events;
+}
\ No newline at end of file
@@ -0,0 +1,319 @@
+/**
+ * @file engine.h
+ * @author Raphael Jouretz (rjouretz.com)
+ * @brief Implement the rules of the snake game, independently of the
+ * gameboy hardware (no gb/gb.h) so it also builds on the host
+ * @version 0.1
+ * @date 2023-06-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <stdint.h>
+
+#include "utils.h"
+
+#ifndef ENGINE_H
+#define ENGINE_H
+
+/** the row stride of the board cells, a power of two so indexing is a shift */
+#define BOARD_STRIDE 32
+
+/** the maximum size of a board, the size of a level is in the level. A row
+ * is at most the stride (and a 32 bits mask for the autopilot), the height
+ * is bound by the WRAM the cells and the snake take. */
+#define BOARD_WIDTH  BOARD_STRIDE
+#define BOARD_HEIGHT 20
+
+/** the number of packed positions a board can have */
+#define POSITION_COUNT (BOARD_HEIGHT * BOARD_STRIDE)
+
+/** one snake slot for every cell inside the border of the largest board */
+#define SNAKE_CAPACITY ((BOARD_WIDTH - 2) * (BOARD_HEIGHT - 2))
+
+/**
+ * @defgroup BOARD_POSITIONS Board positions
+ *
+ * @brief A board position packs x and y within a single uint16_t. x uses
+ * the 5 lower bits (BOARD_STRIDE = 2^5) and y the remaining upper bits, so
+ * a packed position is also the index of the cell in the board cells.
+ * @{
+ */
+#define PACK_POSITION(x, y) (((uint16_t)(y) << 5) | (x))
+#define POSITION_X(pos)     ((uint8_t)((pos)&0x1F))
+#define POSITION_Y(pos)     ((uint8_t)((pos) >> 5))
+/** @} */
+
+/**
+ * @defgroup ENGINE_RULES Engine rules
+ *
+ * @brief The difficulty rules. They can be overridden at build time (e.g.
+ * -DLEVEL_UP_SCORE=10) to tune the game with the host simulator.
+ * @{
+ */
+/** the level increases every time the score is a multiple of this value */
+#ifndef LEVEL_UP_SCORE
+#define LEVEL_UP_SCORE 5
+#endif
+/** the speed of the snake from the level 1, in 1/256 cells per tick (8.8
+ * fixed point). The levels 1 to 7 move every 15 - level * 2 ticks (13, 11,
+ * 9, 7, 5, 3 and 1, rounded to the nearest 1/256 cell), then the speed
+ * rises by 1/32 cell per level up to 1.25 cells per tick. The levels after
+ * the last one keep its speed, and a speed above 256 moves the snake
+ * several cells per tick. */
+#ifndef SNAKE_SPEEDS
+#define SNAKE_SPEEDS                                                       \
+    {20, 23, 28, 37, 51, 85, 256, 264, 272, 280, 288, 296, 304, 312, 320}
+#endif
+/** the loot timer is 1 + (random & mask) ticks, where mask is the loot timer
+ * mask of the level limited to LOOT_TIMER_MASK */
+#ifndef LOOT_TIMER_MASK
+#define LOOT_TIMER_MASK 0xFF
+#endif
+/** the number of turns waiting for the next moves, so a turn given between
+ * two moves is never lost and is applied at most TURN_QUEUE_SIZE moves late */
+#ifndef TURN_QUEUE_SIZE
+#define TURN_QUEUE_SIZE 3
+#endif
+/** @} */
+
+/**
+ * @defgroup ENGINE_INPUTS Engine inputs
+ *
+ * @brief The directions given to StepEngine. The values are the ones of the
+ * gameboy joypad (J_RIGHT, J_LEFT, J_UP and J_DOWN) so the pressed keys can
+ * be given as is.
+ * @{
+ */
+#define INPUT_RIGHT 0x01U
+#define INPUT_LEFT  0x02U
+#define INPUT_UP    0x04U
+#define INPUT_DOWN  0x08U
+/** the opposite of a direction: RIGHT/LEFT are the two lower bits and
+ * UP/DOWN the two next ones */
+#define OPPOSITE_INPUT(dir)                                                 \
+    (((dir) & (INPUT_RIGHT | INPUT_LEFT)) ? (dir) ^ (INPUT_RIGHT | INPUT_LEFT) \
+                                          : (dir) ^ (INPUT_UP | INPUT_DOWN))
+/** @} */
+
+/** non zero if the next tick moves the snake (at least once) */
+#define IS_MOVE_TICK(state) ((state)->moveProgress + (state)->speed >= 0x100)
+
+/**
+ * @defgroup ENGINE_EVENTS Engine events
+ *
+ * @brief The flags returned by StepEngine to tell what changed during the
+ * tick.
+ * @{
+ */
+/** the snake moved to EngineState::lastHead */
+#define EVENT_MOVED     0x01U
+/** the snake ate a loot, so EngineState::lastTail was kept */
+#define EVENT_GROWN     0x02U
+/** the level increased */
+#define EVENT_LEVEL_UP  0x04U
+/** a loot was dropped at EngineState::lastLoot */
+#define EVENT_LOOT      0x08U
+/** the snake hit a wall or itself */
+#define EVENT_GAME_OVER 0x10U
+/** the snake covers every cell that is not a wall */
+#define EVENT_WON       0x20U
+/** @} */
+
+/**
+ * @defgroup LEVEL_FORMAT Level format
+ *
+ * @brief The offsets of the bytes of a level, compiled from
+ * resources/levels.txt by scripts/levels.py. The border of the board is
+ * always a wall, the inner walls are given by rows: a 24 bits mask (LE) of
+ * the inner rows with walls (bit 0 for the row 1), then (width + 7) / 8
+ * bytes (LE) for every row of the mask, with the bit x set for a wall at the
+ * column x.
+ * @{
+ */
+#define LEVEL_SNAKE_X   0
+#define LEVEL_SNAKE_Y   1
+/** the direction of the snake (one of ENGINE_INPUTS) */
+#define LEVEL_DIR       2
+/** the level the snake starts at, which sets its speed */
+#define LEVEL_SPEED     3
+#define LEVEL_LOOT_MASK 4
+/** the size of the board, at most BOARD_WIDTH x BOARD_HEIGHT */
+#define LEVEL_WIDTH     5
+#define LEVEL_HEIGHT    6
+#define LEVEL_ROWS      7
+#define LEVEL_WALLS     10
+/** @} */
+
+/**
+ * @defgroup WALL_TILES Wall tiles
+ *
+ * @brief The tiles of the walls on the board screen: the border is framed,
+ * an inner wall is a block. See the first tile row of sets.bkg.png.
+ * @{
+ */
+#define BLOCK_TILE              0
+#define TOP_LEFT_WALL_TILE      4
+#define TOP_RIGHT_WALL_TILE     5
+#define BOTTOM_RIGHT_WALL_TILE  6
+#define BOTTOM_LEFT_WALL_TILE   7
+#define TOP_WALL_TILE           8
+#define RIGHT_WALL_TILE         9
+#define BOTTOM_WALL_TILE        10
+#define LEFT_WALL_TILE          11
+/** @} */
+
+/** \enum BoardCell
+ * \brief Represent a cell within the game board.
+ *
+ *  See the first tile row of sets.bkg.png to have more info about the order.
+ */
+typedef enum {
+    EMPTY_CELL = 1,
+    SNAKE_CELL,
+    LOOT_CELL,
+    WALL_CELL
+} BoardCell;
+
+/** @struct Snake
+ *  Represent a snake as a ring buffer of packed board positions, from its
+ *  tail to its head.
+ *
+ *  @var Snake::cells
+ *    The packed positions of the snake nodes (see BOARD_POSITIONS).
+ *  @var Snake::head
+ *    The index of the head node within cells.
+ *  @var Snake::tail
+ *    The index of the tail node within cells.
+ *  @var Snake::length
+ *    The number of nodes of the snake.
+ */
+typedef struct {
+    uint16_t cells[SNAKE_CAPACITY];
+    uint16_t head;
+    uint16_t tail;
+    uint16_t length;
+} Snake;
+
+/** @struct FreeCells
+ *  Represent the set of the empty cells of the board by their number in
+ *  every row, the cells themselves are the EMPTY_CELL of the board. Adding
+ *  and removing a cell are O(1), but the n-th empty cell is not: its row is
+ *  found by summing the row counts, then the cell by scanning the row, so at
+ *  most BOARD_HEIGHT + BOARD_STRIDE steps. This is slower than a list of the
+ *  empty cells and its index, but they would take 2.3 KB of WRAM instead of
+ *  22 bytes, and the n-th cell is only looked for when a loot is dropped.
+ *
+ *  @var FreeCells::rowCounts
+ *    The number of empty cells of every row.
+ *  @var FreeCells::count
+ *    The number of empty cells.
+ */
+typedef struct {
+    uint8_t rowCounts[BOARD_HEIGHT];
+    uint16_t count;
+} FreeCells;
+
+/** @struct EngineState
+ *  Represent the whole state of a game. Two states with the same seed and
+ *  given the same inputs always play the same game.
+ *
+ *  @var EngineState::cells
+ *    The cells of the board indexed by packed position (see BoardCell).
+ *  @var EngineState::snake
+ *    The snake.
+ *  @var EngineState::freeCells
+ *    The empty cells of the board, where a loot can be dropped.
+ *  @var EngineState::width
+ *    The width of the board, the cells from it are walls.
+ *  @var EngineState::height
+ *    The height of the board, the cells from it are walls.
+ *  @var EngineState::boardCellCount
+ *    The number of cells that are not walls.
+ *  @var EngineState::random
+ *    The state of the random number generator.
+ *  @var EngineState::dir
+ *    The direction of the last move of the snake (one of ENGINE_INPUTS).
+ *  @var EngineState::turns
+ *    The directions of the next moves, the first one is applied by the next
+ *    move.
+ *  @var EngineState::turnCount
+ *    The number of directions within turns.
+ *  @var EngineState::speed
+ *    The speed of the snake at the current level (see SNAKE_SPEEDS).
+ *  @var EngineState::moveProgress
+ *    The progress of the snake to its next cell, in 1/256 cells.
+ *  @var EngineState::lootTimer
+ *    The number of ticks before the next loot drop.
+ *  @var EngineState::lootTimerMask
+ *    The mask of the random loot timers (see LOOT_TIMER_MASK).
+ *  @var EngineState::score
+ *    The score (the size of the snake, so it can exceed 255).
+ *  @var EngineState::level
+ *    The level, which sets the speed of the snake.
+ *  @var EngineState::lootsToLevelUp
+ *    The number of loots to eat before the next level.
+ *  @var EngineState::lastHead
+ *    The packed position of the head after the last move.
+ *  @var EngineState::lastTail
+ *    The packed position of the tail removed by the last move.
+ *  @var EngineState::lastLoot
+ *    The packed position of the last dropped loot.
+ *  @var EngineState::isOver
+ *    Non zero once the game is over (lost or won).
+ */
+typedef struct {
+    uint8_t cells[POSITION_COUNT];
+    Snake snake;
+    FreeCells freeCells;
+    uint8_t width;
+    uint8_t height;
+    uint16_t boardCellCount;
+    uint16_t random;
+    uint8_t dir;
+    uint8_t turns[TURN_QUEUE_SIZE];
+    uint8_t turnCount;
+    uint16_t speed;
+    uint16_t moveProgress;
+    uint16_t lootTimer;
+    uint8_t lootTimerMask;
+    uint16_t score;
+    uint8_t level;
+    uint8_t lootsToLevelUp;
+    uint16_t lastHead;
+    uint16_t lastTail;
+    uint16_t lastLoot;
+    uint8_t isOver;
+} EngineState;
+
+/** the number of seeds that play different games, from 1 to SEED_COUNT:
+ * the random number generator has 16 bits and the seed 0 is replaced by
+ * 0xACE1 */
+#define SEED_COUNT 0xFFFFU
+
+/**
+ * @brief Initialize the given state with a new game on the given level. The
+ * cells of the board and the tiles of its screen are built in a single pass.
+ *
+ * @param state a pointer to a valid EngineState
+ * @param level the bytes of the level (see LEVEL_FORMAT)
+ * @param seed the seed of the random number generator (any value)
+ * @param tiles set to the tiles of the board indexed by packed position
+ * (POSITION_COUNT tiles, see WALL_TILES). Can be NULL.
+ */
+void InitEngine(EngineState* state, const uint8_t* level, uint16_t seed,
+                uint8_t* tiles);
+
+/**
+ * @brief Run one tick (one frame) of the game.
+ *
+ * @param state a pointer to an initialized EngineState
+ * @param input the directions pressed on this tick (see ENGINE_INPUTS).
+ * Every direction is queued as a turn, unless it is the direction or the
+ * opposite of the last queued turn (or of the snake) or the queue is full.
+ * Other bits are ignored.
+ * @return the events of the tick (see ENGINE_EVENTS)
+ */
+uint8_t StepEngine(EngineState* state, uint8_t input);
+
+#endif
\ No newline at end of file
@@ -2,81 +2,79 @@
 
 #include "graphics.h"
 #include "sound.h"
+#include "sprites.h"
 #include "utils.h"
 
+/*************************************************
+**               private variables              **
+*************************************************/
+
+/** the palette flashes for 25 frames, then waits 41 frames */
+const Keyframe gameOverFlash[] = {
+    REPEAT_KEYFRAME(ACTION_RANDOM_PALETTE, 0, 1, 25),
+    KEYFRAME(ACTION_DEFAULT_PALETTE, 0, 41), END_KEYFRAME};
+
+/** the window rises from the collapsed legend to the top of the screen */
+const Keyframe gameOverWin[] = {REPEAT_KEYFRAME(ACTION_RAISE_WIN, 1, 1, 135),
+                                END_KEYFRAME};
+
+/** the snake sleeps once the window is up */
+const Keyframe gameOverSnake[] = {
+    KEYFRAME(ACTION_SNAKE_FRAME, 0, 206), KEYFRAME(ACTION_SNAKE_FRAME, 1, 8),
+    KEYFRAME(ACTION_SNAKE_FRAME, 2, 8),   KEYFRAME(ACTION_SNAKE_FRAME, 3, 8),
+    KEYFRAME(ACTION_SNAKE_FRAME, 4, 8),   KEYFRAME(ACTION_SNAKE_FRAME, 5, 8),
+    KEYFRAME(ACTION_SNAKE_FRAME, 6, 8),   KEYFRAME(ACTION_SNAKE_FRAME, 7, 8),
+    KEYFRAME(ACTION_SNAKE_FRAME, 8, 8),   KEYFRAME(ACTION_SNAKE_FRAME, 9, 8),
+    END_KEYFRAME};
+
+/** the screen fades out after 329 frames (7 x 47), a step every 3 frames */
+const Keyframe gameOverFadeOut[] = {
+    REPEAT_KEYFRAME(ACTION_WAIT, 0, 47, 7),
+    REPEAT_KEYFRAME(ACTION_DARKEN, 1, 3, BKG_BRIGHTNESS_MAX), END_KEYFRAME};
+
+/*************************************************
+**               public functions               **
+*************************************************/
+
 void RunGameOver()
 {
     /****  prepare  ****/
 
     StopSound();
     HideSnakeSprite();
+    LoadSnakeSheet(SNAKE_SLEEP_SHEET);
+    // the window rises over the whole screen
+    HideHudBand();
 
     /****  play damage  ****/
 
-    BOOLEAN isDamaged = TRUE;
-
-    FlashState flashState;
-    flashState = CreateFlashState(1, 24);
-
-    while (isDamaged) {
-        if (isDamaged) isDamaged = UpdateFlash(&flashState);
-        Delay(1);
-    }
-
-    /****  wait  ****/
+    PlayTrack(PALETTE_TRACK, gameOverFlash);
 
-    Delay(40);
+    while (UpdateTimeline()) Delay(1);
 
     /****  play sound  ****/
 
     PlayGameOverSound(FALSE);
 
-    /****  set animation states  ****/
-
-    BOOLEAN isWinExpanding = TRUE;
-    BOOLEAN isSnakeAnimated = FALSE;
-    BOOLEAN isFadeOut = FALSE;
-
-    ExpandWinState expandWinState;
-    SnakeAnimState snakeAnimState;
-    FadeState fadeState;
-    expandWinState = CreateExpandWinState(1, 1);
-    snakeAnimState = CreateSnakeAnimState(8, FALSE, 8, 1, SLEEPING_SNAKE_ID);
-    fadeState = CreateFadeState(12);
+    /****  play animations  ****/
 
     // move the snake out of the screen so it will eventually scroll
     // to the correct position
     MoveSnakeSprite(80, 208);
-    // update the first frame of the correct snake
-    UpdateSnakeAnimState(&snakeAnimState);
-    // show the first frame of the snake outside the screen
+    // show the snake outside the screen, its first frame is set by the first
+    // update
     ShowSnakeSprite();
 
-    uint16_t gameOverTimer = 330;
+    PlayTrack(MAP_TRACK, gameOverWin);
+    PlayTrack(SPRITE_TRACK, gameOverSnake);
+    PlayTrack(PALETTE_TRACK, gameOverFadeOut);
 
     /****  game over loop  ****/
 
-    while (TRUE) {
-        gameOverTimer--;
-        if (gameOverTimer == 0) isFadeOut = TRUE;
-
-        if (isWinExpanding) {
-            isWinExpanding = UpdateExpandWin(&expandWinState);
-            if (isWinExpanding)
-                ScrollSnakeSprite(0, -1);
-            else
-                isSnakeAnimated = TRUE;
-        }
-        if (isSnakeAnimated)
-            isSnakeAnimated = UpdateSnakeAnimState(&snakeAnimState);
-
-        if (isFadeOut) {
-            isFadeOut = UpdateFadeOut(&fadeState);
-            if (!isFadeOut) break;
-        }
-
+    // the fade out is the last track to end
+    while (UpdateTimeline()) {
+        UpdateSprites();
         UpdateSound();
-
         Delay(1);
     }
 
@@ -1,352 +1,1103 @@
 #include "graphics.h"
 
 #include <rand.h>
-#include <resources/sets.h>
-#include <resources/snake.h>
-#include <resources/snake_sleep.h>
+#include <stddef.h>
+#include <resources/palettes.h>
+#include <resources/sets_packed.h>
+#include <resources/snake_packed.h>
+#include <resources/snake_sleep_packed.h>
+
+#include "sprites.h"
+#include "tiles.h"
+#include "transfer.h"
+#include "unpack.h"
+
+#if FADE_STEP_COUNT != BKG_BRIGHTNESS_MAX + 1
+#error "the fade tables do not match BKG_BRIGHTNESS_MAX"
+#endif
+
+/** the two snake animation (awake and sleeping) are composed of 10 frames */
+#define SNAKE_FRAME_COUNT 10
+
+/** the frames of a snake animation are side by side, 2 tiles wide */
+#define SNAKE_SHEET_WIDTH (SNAKE_FRAME_COUNT * 2)
+
+/** when checking sets.bkg.png, the 0 tile is the 64 different tile from
+// the begining of the image */
+#define DIGIT_0_ORIGIN 64
+
+/** the width of the hardware maps, in tiles */
+#define MAP_STRIDE 32
+
+/** the row of "press START" in the menu */
+#define START_TEXT_ROW 14
+
+/** the position of the board select in the menu ("BOARD" and 2 digits) */
+#define BOARD_SELECT_ROW    16
+#define BOARD_SELECT_COLUMN 6
+#define BOARD_SELECT_WIDTH  8
+
+/** no sheet of the snake is loaded */
+#define NO_SNAKE_SHEET 0xFF
+
+/** the number of lines of the screen */
+#define SCREEN_HEIGHT 144
+
+/** the first line of the collapsed window (the legend) */
+#define HUD_LINE 136
+
+/** the part of the screen that shows the board, in tiles (the legend covers
+ * the last row) */
+#define BOARD_VIEW_WIDTH  MAX_TILE_WIDTH
+#define BOARD_VIEW_HEIGHT (MAX_TILE_HEIGHT - 1)
+
+/** the LYC value that never matches a line, when the palette is not split */
+#define NO_SPLIT 0xFF
+
+/** the checks of STAT the split palette waits for the HBlank at most: a check
+ * takes about 10 cycles and the drawing of a line at most 72, so the bound is
+ * only reached when the HBlank was missed */
+#define SPLIT_WAIT_CHECKS 12
+
+/** the number of digits of the score and the level in the legend */
+#define SCORE_DIGITS 3
+#define LEVEL_DIGITS 2
+
+/** a shown packed BCD value that differs from any value on every digit */
+#define NOT_SHOWN 0xFFFF
 
 /**
- * @defgroup SCREEN_COLORS Screen Colors
+ * @defgroup TILE_QUEUE Tile queue
  *
- * @brief Represent the 4 possible colors of the gameboy screen.
+ * @brief the sizes of the queue of tile writes flushed during VBlank
  * @{
  */
-#define WHITE      0
-#define LIGHT_GRAY 1
-#define DARK_GRAY  2
-#define BLACK      3
+/** the maximum number of queued runs */
+#define TILE_RUN_COUNT    32
+/** the maximum number of queued tiles */
+#define TILE_QUEUE_SIZE   64
+/** the maximum number of tiles written per VBlank (and per run) */
+#define TILE_FLUSH_BUDGET 16
 /** @} */
 
 /**
- * @defgroup SET_ORIGINS Set origins
+ * @defgroup BOARD_CAMERA Board camera
  *
- * @brief the origin indices are the first tile index of the wanted data
- * from sets.bkg.png
+ * @brief the camera scrolls the background over the boards larger than the
+ * screen. A board fits the 32x32 background map, so a cell is always at its
+ * board position in the map, but only the cells in view are written: the
+ * strips (a row or a column) the camera reveals are streamed at VBlank.
  * @{
  */
-#define MENU_BKG_ORIGIN        120
-#define PRESS_START_TXT_ORIGIN 400
-#define BOARD_BKG_ORIGIN       480
-#define GAME_OVER_WIN_ORIGIN   840
+/** the largest move of the camera per frame on each axis, in pixels. Less
+ * than a tile, so a move reveals at most one strip per axis */
+#define CAMERA_STEP    4
+/** the tiles in view, with the partly shown column and row */
+#define LOADED_COLUMNS (BOARD_VIEW_WIDTH + 1)
+#define LOADED_ROWS    (BOARD_VIEW_HEIGHT + 1)
 /** @} */
 
-/** the two snake animation (awake and sleeping) are composed of 10 frames */
-#define SNAKE_FRAME_COUNT 10
+/**
+ * @defgroup BKG_MAPS Background maps
+ *
+ * @brief the menu and the board have their own background map, so a screen
+ * is written while the other one is in view and the switch is the LCDC map
+ * bit, set at the next VBlank. The window uses the map of the menu: the two
+ * are never shown at the same time.
+ * @{
+ */
+#define BOARD_MAP ((uint8_t*)_SCRN0)
+#define MENU_MAP  ((uint8_t*)_SCRN1)
+/** @} */
 
-/** when checking sets.bkg.png, the 0 tile is the 64 different tile from
-// the begining of the image */
-#define DIGIT_0_ORIGIN 64
+/*************************************************
+**                 structures                   **
+*************************************************/
+
+/** @struct TileRun
+ *  Represent queued tiles that are next to each other on a map row.
+ *
+ *  @var TileRun::x
+ *    The x position of the first tile
+ *  @var TileRun::y
+ *    The y position of the row
+ *  @var TileRun::length
+ *    The number of tiles
+ *  @var TileRun::isWin
+ *    True if the tiles are on the window map, false for the background
+ *  @var TileRun::offset
+ *    The index of the first tile within queuedTiles
+ */
+typedef struct {
+    uint8_t x;
+    uint8_t y;
+    uint8_t length;
+    BOOLEAN isWin;
+    uint8_t offset;
+} TileRun;
+
+/** @struct BoardCamera
+ *  Represent the view of the background on the board. The loaded tiles are
+ *  the LOADED_COLUMNS x LOADED_ROWS tiles from the tile of (x, y), within
+ *  the board.
+ *
+ *  @var BoardCamera::x
+ *    The scroll of the view (SCX), in pixels
+ *  @var BoardCamera::y
+ *    The scroll of the view (SCY), in pixels
+ *  @var BoardCamera::maxX
+ *    The largest x, so the view never leaves the board
+ *  @var BoardCamera::maxY
+ *    The largest y, so the view never leaves the board
+ *  @var BoardCamera::width
+ *    The width of the board, in tiles
+ *  @var BoardCamera::height
+ *    The height of the board, in tiles
+ */
+typedef struct {
+    uint8_t x;
+    uint8_t y;
+    uint8_t maxX;
+    uint8_t maxY;
+    uint8_t width;
+    uint8_t height;
+} BoardCamera;
+
+/** @struct TileStrip
+ *  Represent a row or a column of board tiles revealed by the camera.
+ *
+ *  @var TileStrip::x
+ *    The x position of the first tile
+ *  @var TileStrip::y
+ *    The y position of the first tile
+ *  @var TileStrip::width
+ *    The width of the strip (1 for a column)
+ *  @var TileStrip::height
+ *    The height of the strip (1 for a row)
+ *  @var TileStrip::tiles
+ *    The tiles, row by row
+ */
+typedef struct {
+    uint8_t x;
+    uint8_t y;
+    uint8_t width;
+    uint8_t height;
+    const uint8_t* tiles;
+} TileStrip;
+
+/** @struct LegendCounter
+ *  Represent a number of the legend, counted in packed BCD (4 bits per
+ *  decimal digit) so the digits are read without any divide.
+ *
+ *  @var LegendCounter::value
+ *    The binary value
+ *  @var LegendCounter::bcd
+ *    The same value in packed BCD
+ *  @var LegendCounter::shownBcd
+ *    The packed BCD value on the screen, or NOT_SHOWN
+ */
+typedef struct {
+    uint16_t value;
+    uint16_t bcd;
+    uint16_t shownBcd;
+} LegendCounter;
+
+/** @struct Track
+ *  Represent a track of the timeline playing a keyframe table.
+ *
+ *  @var Track::keyframes
+ *    The first keyframe of the table (the target of ACTION_JUMP)
+ *  @var Track::keyframe
+ *    The keyframe to run, or NULL if the track is not playing
+ *  @var Track::timer
+ *    The number of frames before the keyframe runs
+ *  @var Track::count
+ *    The number of runs left to the keyframe
+ */
+typedef struct {
+    const Keyframe* keyframes;
+    const Keyframe* keyframe;
+    uint8_t timer;
+    uint8_t count;
+} Track;
+
+/*************************************************
+**               private variables              **
+*************************************************/
+
+/** the tracks of the timeline */
+Track tracks[TRACK_COUNT];
+
+/** the tiles of the whole board indexed by packed position, built by the
+ * engine from the level and kept up to date by SetBoardCell. ShowBoardBkg
+ * replaces the tiles by their slots, then the camera streams the strips it
+ * reveals from it. */
+uint8_t boardBkgMap[POSITION_COUNT];
+
+/** the view on the board, and the scroll the VBlank handler sets */
+BoardCamera camera;
+volatile uint8_t scrollX;
+volatile uint8_t scrollY;
+
+/** the LCDC flag of the background map to show (0 or LCDCF_BG9C00), set by
+ * the VBlank handler with the scroll */
+volatile uint8_t bkgMapFlag;
+
+/** whether the screen asked by ShowMenuBkg or ShowBoardBkg is being copied */
+volatile BOOLEAN isBkgPending;
+
+/** the tile sets of the screens (in ROM, the lists are in the bank of
+ * sets_packed) and the one acquired by the screen in view */
+const TileSet menuTileSet = {sets_menu_tileset, sets_menu_tiles_packed,
+                             sets_menu_TILESET_SIZE};
+const TileSet boardTileSet = {sets_board_tileset, sets_board_tiles_packed,
+                              sets_board_TILESET_SIZE};
+const TileSet* screenTileSet;
+
+/** the sheet of the snake in the sprite tiles */
+uint8_t snakeSheet;
+
+/** the menu, copied from WRAM to its map by the transfers. The game over
+ * screen of the window is staged there too: the window uses the map of the
+ * menu, and the two are never shown at the same time. */
+uint8_t menuTiles[sets_MAP_WIDTH * sets_menu_MAP_HEIGHT];
+
+#if sets_game_over_MAP_HEIGHT > sets_menu_MAP_HEIGHT
+#error "the game over screen does not fit in the menu tiles"
+#endif
+
+/** the game over screen, staged and copied row by row as the window rises */
+Unpacker winUnpacker;
+uint8_t winRowCount;
+
+/** the strip written at the next VBlank, before the scroll that reveals it.
+ * The columns are gathered in stripTiles, a row is read in boardBkgMap. */
+TileStrip strip;
+uint8_t stripTiles[LOADED_ROWS];
+volatile BOOLEAN isStripPending;
+
+/** "BOARD" in the font of sets.bkg.png (png indices of the menu tile set) */
+const uint8_t boardSelectText[] = {13, 26, 12, 29, 15};
+
+/** the 2x2 layout of the snake frames (in ROM) */
+const SpritePart snakeParts[] = {{0, 0, 0},
+                                 {8, 0, 1},
+                                 {0, 8, SNAKE_SHEET_WIDTH},
+                                 {8, 8, SNAKE_SHEET_WIDTH + 1}};
+const Metasprite snakeMetasprite = {snakeParts, 4};
+
+/** the score and the level of the legend */
+LegendCounter legendScore = {0, 0, NOT_SHOWN};
+LegendCounter legendLevel = {0, 0, NOT_SHOWN};
+
+/** the queued runs, runIndex is the next one to flush */
+TileRun tileRuns[TILE_RUN_COUNT];
+volatile uint8_t runCount;
+volatile uint8_t runIndex;
+
+/** the palette of the background above the split (or of the whole screen) */
+volatile uint8_t bkgPalette;
+
+/** the palette of the background from the split line */
+volatile uint8_t splitPalette;
+uint8_t splitLine;
+
+/** the fade step of the palettes (0 to BKG_BRIGHTNESS_MAX) */
+uint8_t brightness;
+
+/** the tiles of the queued runs, in the order of the runs */
+uint8_t queuedTiles[TILE_QUEUE_SIZE];
+volatile uint8_t tileCount;
 
 /*************************************************
 **              private functions               **
 *************************************************/
 
 /**
- * @brief Set the background palette to (c0, c1, c2, c3) with
- * cx in [WHITE, LIGHT_GRAY, DARK_GRAY, BLACK]
+ * @brief Queue a tile write, it is done by FlushTiles at the next VBlank. A
+ * tile next to the last queued one on the same row extends its run.
  *
- * @param c0 the first color of the palette
- * @param c1 the second color of the palette
- * @param c2 the third color of the palette
- * @param c3 the fourth color of the palette
+ * Wait for a VBlank if the queue is full, so the VBlank interrupt must be
+ * enabled.
+ *
+ * @param x the x position
+ * @param y the y position
+ * @param tile the tile to set
+ * @param isWin true for the window map, false for the background map
  */
-void SetBkgPalette(uint8_t c0, uint8_t c1, uint8_t c2, uint8_t c3)
+void QueueTile(uint8_t x, uint8_t y, uint8_t tile, BOOLEAN isWin)
 {
-    BGP_REG = c0 | c1 << 2 | c2 << 4 | c3 << 6;
+    while (runCount == TILE_RUN_COUNT || tileCount == TILE_QUEUE_SIZE)
+        wait_vbl_done();
+
+    // FlushTiles must not see a run while it is updated, the interrupts are
+    // restored as they were
+    CRITICAL {
+        BOOLEAN isExtended = FALSE;
+
+        // the last run is still in the queue and ends right before the tile
+        if (runCount > runIndex) {
+            TileRun* last = &tileRuns[runCount - 1];
+
+            if (last->y == y && last->isWin == isWin &&
+                last->x + last->length == x &&
+                last->length < TILE_FLUSH_BUDGET) {
+                last->length++;
+                isExtended = TRUE;
+            }
+        }
+
+        if (!isExtended) {
+            TileRun* run = &tileRuns[runCount++];
+            run->x = x;
+            run->y = y;
+            run->length = 1;
+            run->isWin = isWin;
+            run->offset = tileCount;
+        }
+
+        queuedTiles[tileCount++] = tile;
+    }
 }
 
 /**
- * @brief Set the sprite palette to (c0, c1, c2, c3) with
- * cx in [WHITE, LIGHT_GRAY, DARK_GRAY, BLACK]
+ * @brief Add a digit to a packed BCD value.
  *
- * @param c0 the first color of the palette
- * @param c1 the second color of the palette
- * @param c2 the third color of the palette
- * @param c3 the fourth color of the palette
+ * @param bcd the packed BCD value
+ * @param digit the digit to add (0 to 9)
+ * @return the packed BCD sum (the carry out of the 4th digit is lost)
  */
-void SetSpritePalette(uint8_t c0, uint8_t c1, uint8_t c2, uint8_t c3)
+uint16_t AddBcd(uint16_t bcd, uint8_t digit)
 {
-    OBP0_REG = c0 | c1 << 2 | c2 << 4 | c3 << 6;
+    // add to the ones, then carry to the next digits while they overflow
+    for (uint8_t shift = 0; digit && shift < 16; shift += 4) {
+        uint8_t sum = ((bcd >> shift) & 0x0F) + digit;
+
+        digit = 0;
+        if (sum > 9) {
+            sum -= 10;
+            digit = 1;
+        }
+
+        bcd = (bcd & ~((uint16_t)0x0F << shift)) | ((uint16_t)sum << shift);
+    }
+
+    return bcd;
 }
 
 /**
- * @brief Set the Brightness of the screen (0 to BKG_BRIGHTNESS_MAX)
+ * @brief Count a legend number up to a value and queue the digits that
+ * changed since they were last shown.
  *
- * @param brightness
+ * @param counter a pointer to a valid LegendCounter
+ * @param value the value to show
+ * @param x the x position of the first digit in the window
+ * @param digitCount the number of digits to show
  */
-void SetBrightness(uint8_t brightness)
+void SetLegendCounter(LegendCounter* counter, uint16_t value, uint8_t x,
+                      uint8_t digitCount)
 {
-    if (brightness == 0) {
-        SetBkgPalette(BLACK, BLACK, BLACK, BLACK);
-        SetSpritePalette(BLACK, BLACK, BLACK, BLACK);
-    }
-    else if (brightness == 1) {
-        SetBkgPalette(DARK_GRAY, BLACK, BLACK, BLACK);
-        SetSpritePalette(BLACK, BLACK, BLACK, DARK_GRAY);
+    // the values only go up during a game, a lower one is a new game
+    if (value < counter->value) {
+        counter->value = 0;
+        counter->bcd = 0;
     }
-    else if (brightness == 2) {
-        SetBkgPalette(LIGHT_GRAY, DARK_GRAY, BLACK, BLACK);
-        SetSpritePalette(BLACK, DARK_GRAY, BLACK, LIGHT_GRAY);
+
+    // mostly a single increment, the value changes by one at a time
+    while (counter->value != value) {
+        uint16_t step = value - counter->value;
+        if (step > 9) step = 9;
+
+        counter->bcd = AddBcd(counter->bcd, step);
+        counter->value += step;
     }
-    else {
-        SetBkgPalette(WHITE, LIGHT_GRAY, DARK_GRAY, BLACK);
-        SetSpritePalette(BLACK, LIGHT_GRAY, DARK_GRAY, WHITE);
+
+    // queued from left to right, so the changed digits next to each other are
+    // a single run
+    uint16_t changed = counter->bcd ^ counter->shownBcd;
+    uint8_t shift = digitCount << 2;
+
+    for (; digitCount; digitCount--, x++) {
+        shift -= 4;
+        if ((changed >> shift) & 0x0F) {
+            uint8_t digit = (counter->bcd >> shift) & 0x0F;
+            QueueTile(x, 0, GetTileSlot(DIGIT_0_ORIGIN + digit), TRUE);
+        }
     }
+
+    counter->shownBcd = counter->bcd;
 }
 
 /**
- * @brief Display a given frame of the AWAKE_SNAKE_ID snake
+ * @brief Set the background palette. When the palette is split, it is the
+ * palette of the lines above the split.
  *
- * @param frame the frame to display (0 to SNAKE_FRAME_COUNT)
+ * @param palette the BGP_REG value
  */
-void DisplaySnakeSprite(uint8_t frame)
+void SetBkgPalette(uint8_t palette)
 {
-    set_sprite_tile(0, frame * 2);
-    set_sprite_tile(1, frame * 2 + 1);
-    set_sprite_tile(2, frame * 2 + 20);
-    set_sprite_tile(3, frame * 2 + 21);
+    bkgPalette = palette;
+
+    // with a split, the VBlank handler sets it for the next frame
+    if (LYC_REG == NO_SPLIT) BGP_REG = palette;
 }
 
 /**
- * @brief Display a given frame of the SLEEPING_SNAKE_ID snake
+ * @brief Set the sprite palette.
  *
- * @param frame the frame to display (0 to SNAKE_FRAME_COUNT)
+ * @param palette the OBP0_REG value
  */
-void DisplaySnakeSleepSprite(uint8_t frame)
+void SetSpritePalette(uint8_t palette)
 {
-    set_sprite_tile(0, snake_TILE_COUNT + frame * 2);
-    set_sprite_tile(1, snake_TILE_COUNT + frame * 2 + 1);
-    set_sprite_tile(2, snake_TILE_COUNT + frame * 2 + 20);
-    set_sprite_tile(3, snake_TILE_COUNT + frame * 2 + 21);
+    OBP0_REG = palette;
 }
 
 /**
- * @brief Set the default palette of the background and sprites.
+ * @brief Set the Brightness of the screen (0 to BKG_BRIGHTNESS_MAX)
  *
+ * @param level the fade step, 0 is black
  */
-void SetDefaultPalette()
+void SetBrightness(uint8_t level)
 {
-    SetBkgPalette(WHITE, LIGHT_GRAY, DARK_GRAY, BLACK);
-    SetSpritePalette(BLACK, LIGHT_GRAY, DARK_GRAY, WHITE);
+    brightness = level;
+    SetBkgPalette(fadeBkgPalettes[level]);
+    SetSpritePalette(fadeSpritePalettes[level]);
 }
 
 /**
- * @brief Set a random palette for the background and sprites.
+ * @brief Split the background palette: the lines from the given one use
+ * another palette.
  *
+ * @param line the first line of the split (1 to SCREEN_HEIGHT - 1)
+ * @param palette the BGP_REG value of the lines from the split
  */
-void SetRandomPalette()
+void SetPaletteSplit(uint8_t line, uint8_t palette)
 {
-    uint8_t seed = rand() % 4;
+    splitPalette = palette;
+    splitLine = line;
 
-    if (seed == 0) {
-        SetBkgPalette(BLACK, DARK_GRAY, BLACK, DARK_GRAY);
-        SetSpritePalette(BLACK, DARK_GRAY, BLACK, DARK_GRAY);
-    }
-    else if (seed == 1) {
-        SetBkgPalette(LIGHT_GRAY, WHITE, BLACK, DARK_GRAY);
-        SetSpritePalette(BLACK, WHITE, DARK_GRAY, WHITE);
-    }
-    else if (seed == 2) {
-        SetBkgPalette(BLACK, DARK_GRAY, BLACK, BLACK);
-        SetSpritePalette(BLACK, DARK_GRAY, BLACK, LIGHT_GRAY);
+    // the interrupt of the line before waits for its HBlank
+    LYC_REG = line - 1;
+}
+
+/**
+ * @brief Show the whole screen with the background palette.
+ *
+ */
+void ClearPaletteSplit()
+{
+    LYC_REG = NO_SPLIT;
+    BGP_REG = bkgPalette;
+}
+
+/**
+ * @brief Move a black wipe down the screen: the lines above the split are
+ * black, the lines from the split keep their palette. The first wipe starts
+ * at the top of the screen.
+ *
+ * @param lines the number of lines to add to the wipe
+ */
+void WipeOut(uint8_t lines)
+{
+    if (LYC_REG == NO_SPLIT) {
+        SetPaletteSplit(lines, bkgPalette);
+        SetBkgPalette(fadeBkgPalettes[0]);
     }
-    else {
-        SetBkgPalette(WHITE, LIGHT_GRAY, WHITE, LIGHT_GRAY);
-        SetSpritePalette(BLACK, LIGHT_GRAY, WHITE, WHITE);
+    else if (splitLine + lines < SCREEN_HEIGHT)
+        SetPaletteSplit(splitLine + lines, splitPalette);
+    else
+        ClearPaletteSplit();
+}
+
+/**
+ * @brief The LCD handler: set the split palette once the line before the
+ * split is drawn.
+ *
+ */
+void ApplySplitPalette()
+{
+    uint8_t line = LY_REG;
+
+    // the HBlank interrupts of the transfers come on every line, and may hide
+    // the LYC one: the split is then set a line late
+    if (line < LYC_REG) return;
+
+    // the interrupt comes at the start of the line before the split, the
+    // palette changes in its HBlank so no line is drawn with both palettes.
+    // The transfers share the interrupt, so the wait is bounded to the
+    // drawing of the line, and a late interrupt writes at once.
+    if (line == LYC_REG) {
+        uint8_t checks = SPLIT_WAIT_CHECKS;
+        while ((STAT_REG & STATF_BUSY) && --checks);
     }
+
+    BGP_REG = splitPalette;
 }
 
-/*************************************************
-**               public functions               **
-*************************************************/
+/**
+ * @brief Get the scroll of the camera that centers a cell, within the
+ * board.
+ *
+ * @param cell the x (or y) position of the cell
+ * @param max the largest scroll (BoardCamera::maxX or maxY)
+ * @param view the width (or height) of the view, in tiles
+ * @return the scroll, in pixels
+ */
+uint8_t CameraTarget(uint8_t cell, uint8_t max, uint8_t view)
+{
+    int16_t target = ((int16_t)cell << 3) + 4 - ((int16_t)view << 2);
 
-void ShowMenuBkg()
+    if (target < 0) return 0;
+    if (target > max) return max;
+    return target;
+}
+
+/**
+ * @brief Move a scroll of the camera toward its target, by CAMERA_STEP
+ * pixels at most.
+ *
+ * @param scroll the scroll, in pixels
+ * @param target the scroll to reach, in pixels
+ * @return the new scroll
+ */
+uint8_t StepCamera(uint8_t scroll, uint8_t target)
 {
-    set_bkg_tiles(0, 0, 20, 18, sets_map + MENU_BKG_ORIGIN);
-    SHOW_BKG;
+    if (target > scroll + CAMERA_STEP) return scroll + CAMERA_STEP;
+    if (target + CAMERA_STEP < scroll) return scroll - CAMERA_STEP;
+    return target;
 }
 
-void ShowBoardBkg()
+/**
+ * @brief Get whether the tile of a cell is in the loaded part of the
+ * background map.
+ *
+ * @param x the x position of the cell
+ * @param y the y position of the cell
+ * @return true if the tile is loaded
+ */
+BOOLEAN IsCellLoaded(uint8_t x, uint8_t y)
 {
-    set_bkg_tiles(0, 0, 20, 18, sets_map + BOARD_BKG_ORIGIN);
-    SHOW_BKG;
+    // the positions before the first loaded tile wrap to large values
+    return (uint8_t)(x - (camera.x >> 3)) < LOADED_COLUMNS &&
+           (uint8_t)(y - (camera.y >> 3)) < LOADED_ROWS;
 }
 
-void ShowWin()
+/**
+ * @brief Prepare the loaded tiles of a board column as the next strip.
+ *
+ * @param x the x position of the column
+ */
+void PrepareColumn(uint8_t x)
 {
-    set_win_tiles(0, 0, 20, 18, sets_map + GAME_OVER_WIN_ORIGIN);
-    SHOW_WIN;
+    uint8_t y = camera.y >> 3;
+    uint8_t count = camera.height - y;
+    if (count > LOADED_ROWS) count = LOADED_ROWS;
+
+    // the partly shown column right of a board is never in view
+    if (x >= camera.width) return;
+
+    const uint8_t* tile = &boardBkgMap[PACK_POSITION(x, y)];
+    for (uint8_t i = 0; i < count; i++, tile += BOARD_STRIDE)
+        stripTiles[i] = *tile;
+
+    strip.x = x;
+    strip.y = y;
+    strip.width = 1;
+    strip.height = count;
+    strip.tiles = stripTiles;
+    isStripPending = TRUE;
 }
 
-void HideWin()
+/**
+ * @brief Prepare the loaded tiles of a board row as the next strip.
+ *
+ * @param y the y position of the row
+ */
+void PrepareRow(uint8_t y)
 {
-    HIDE_WIN;
+    uint8_t x = camera.x >> 3;
+    uint8_t count = camera.width - x;
+    if (count > LOADED_COLUMNS) count = LOADED_COLUMNS;
+
+    // the partly shown row under a board is behind the legend
+    if (y >= camera.height) return;
+
+    strip.x = x;
+    strip.y = y;
+    strip.width = count;
+    strip.height = 1;
+    strip.tiles = &boardBkgMap[PACK_POSITION(x, y)];
+    isStripPending = TRUE;
 }
 
-void ShowStartText()
+/**
+ * @brief Set the scroll and the background map of the view. Only called at
+ * VBlank.
+ *
+ */
+void ApplyView()
 {
-    // set back the map of the "press start" row
-    set_bkg_tiles(0, 14, 20, 1, sets_map + PRESS_START_TXT_ORIGIN);
+    SCX_REG = scrollX;
+    SCY_REG = scrollY;
+
+    // a new screen shows with its scroll
+    LCDC_REG = (LCDC_REG & ~LCDCF_BG9C00) | bkgMapFlag;
 }
 
-void HideStartText()
+/**
+ * @brief Show the menu once it is copied (transfer callback, at VBlank).
+ *
+ * @param done the number of bytes copied
+ * @param size the number of bytes of the transfer
+ */
+void ShowMenuMap(uint16_t done, uint16_t size)
 {
-    // replace every characters of "press start" to black (id=0)
-    const unsigned char map[] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-    set_bkg_tiles(4, 14, 12, 1, map);
+    scrollX = 0;
+    scrollY = 0;
+    bkgMapFlag = LCDCF_BG9C00;
+    ApplyView();
+
+    isBkgPending = FALSE;
 }
 
-void CollapseWin()
+/**
+ * @brief Show the board once it is copied (transfer callback, at VBlank).
+ *
+ * @param done the number of bytes copied
+ * @param size the number of bytes of the transfer
+ */
+void ShowBoardMap(uint16_t done, uint16_t size)
 {
-    move_win(7, 136);
+    scrollX = camera.x;
+    scrollY = camera.y;
+    bkgMapFlag = 0;
+    ApplyView();
+
+    isBkgPending = FALSE;
 }
 
-BlinkingStartTextState CreateBlinkingStartTextState(uint8_t timer,
-                                                    BOOLEAN isVisibleAtStart,
-                                                    int8_t startDelay)
+/**
+ * @brief Queue the copy of a block of tiles to a map.
+ *
+ * @param x the x position of the block
+ * @param y the y position of the block
+ * @param w the width of the block
+ * @param h the height of the block
+ * @param map the VRAM address of the map (BOARD_MAP or MENU_MAP)
+ * @param tiles the first tile of the block (in WRAM)
+ * @param stride the distance between two rows of tiles
+ * @param onDone called once the block is copied (can be NULL)
+ */
+void QueueMapTransfer(uint8_t x, uint8_t y, uint8_t w, uint8_t h,
+                      uint8_t* map, const uint8_t* tiles, uint8_t stride,
+                      TransferCallback onDone)
 {
-    BlinkingStartTextState state = {timer, isVisibleAtStart, startDelay, 0};
-    return state;
+    Transfer transfer;
+
+    transfer.dest = map + ((uint16_t)y * MAP_STRIDE) + x;
+    transfer.src = tiles;
+    transfer.width = w;
+    transfer.height = h;
+    transfer.destStride = MAP_STRIDE;
+    transfer.srcStride = stride;
+    transfer.onProgress = NULL;
+    transfer.onDone = onDone;
+
+    QueueTransfer(&transfer);
 }
 
-SnakeAnimState CreateSnakeAnimState(uint8_t timer, BOOLEAN isLoop,
-                                    uint8_t startDelay,
-                                    uint8_t waitBetweenLoop, uint8_t snakeId)
+/**
+ * @brief Write the strip revealed by the camera, then scroll the view and
+ * select the background map. Run by the VBlank handler, so a strip is never
+ * shown before it is written.
+ *
+ */
+void StreamStrip()
 {
-    SnakeAnimState state = {timer,   isLoop, startDelay, waitBetweenLoop,
-                            snakeId, 0,      0};
-    return state;
+    if (isStripPending) {
+        set_tiles(strip.x, strip.y, strip.width, strip.height, BOARD_MAP,
+                  strip.tiles);
+        isStripPending = FALSE;
+    }
+
+    ApplyView();
+}
+
+/**
+ * @brief The VBlank handler: restore the palette of the top lines, stream
+ * the board and write the queued tiles. At most a strip (LOADED_COLUMNS
+ * tiles) and TILE_FLUSH_BUDGET tiles are written per VBlank.
+ *
+ */
+void RefreshScreen()
+{
+    if (LYC_REG != NO_SPLIT) BGP_REG = bkgPalette;
+
+    StreamStrip();
+    FlushTiles();
+}
+
+/**
+ * @brief Queue the copy of the next rows of the game over screen to the
+ * window.
+ *
+ * @param count the number of rows to have (at most
+ * sets_game_over_MAP_HEIGHT)
+ */
+void UnpackWinRows(uint8_t count)
+{
+    for (; winRowCount < count; winRowCount++) {
+        uint8_t* row = &menuTiles[winRowCount * sets_MAP_WIDTH];
+
+        Unpack(&winUnpacker, row, sets_MAP_WIDTH);
+        MapTileSlots(row, sets_MAP_WIDTH);
+        QueueMapTransfer(0, winRowCount, sets_MAP_WIDTH, 1, MENU_MAP, row,
+                         sets_MAP_WIDTH, NULL);
+    }
 }
 
-ExpandWinState CreateExpandWinState(uint8_t timer, uint8_t speed)
+/**
+ * @brief Raise the window and the snake. The rows of the window are queued
+ * one row before they reach the screen, so they are copied before they
+ * show.
+ *
+ * @param lines the number of lines to raise the window by
+ */
+void RaiseWin(uint8_t lines)
 {
-    ExpandWinState state = {timer, speed, 0};
-    return state;
+    uint8_t line = WY_REG - lines;
+
+    if (line < SCREEN_HEIGHT) {
+        uint8_t count = ((SCREEN_HEIGHT - 1 - line) >> 3) + 2;
+        if (count > sets_game_over_MAP_HEIGHT)
+            count = sets_game_over_MAP_HEIGHT;
+
+        UnpackWinRows(count);
+    }
+
+    scroll_win(0, -lines);
+    ScrollSnakeSprite(0, -lines);
 }
-FadeState CreateFadeState(uint8_t timer)
+
+/**
+ * @brief Display a given frame of the loaded snake sheet (see
+ * LoadSnakeSheet)
+ *
+ * @param frame the frame to display (0 to SNAKE_FRAME_COUNT)
+ */
+void DisplaySnakeSprite(uint8_t frame)
 {
-    FadeState state = {timer, 0, 0};
-    return state;
+    SetSpriteObjectTile(SNAKE_OBJECT, frame * 2);
 }
 
-FlashState CreateFlashState(uint8_t timer, uint8_t duration)
+/**
+ * @brief Acquire the tile set of the next screen, then release the one of
+ * the screen in view: the tiles they share keep their slots and the others
+ * are loaded in slots the screen in view does not use.
+ *
+ * @param set a pointer to the TileSet of the next screen
+ */
+void AcquireScreenTiles(const TileSet* set)
 {
-    FlashState state = {timer, duration, 0};
-    return state;
+    AcquireTileSet(set, BANK(sets_packed));
+    if (screenTileSet) ReleaseTileSet(screenTileSet, BANK(sets_packed));
+    screenTileSet = set;
 }
 
-BOOLEAN UpdateExpandWin(ExpandWinState* state)
+/**
+ * @brief Set the default palette of the background and sprites.
+ *
+ */
+void SetDefaultPalette()
 {
-    if (WY_REG <= 1) return FALSE;
+    SetBrightness(BKG_BRIGHTNESS_MAX);
+}
 
-    state->curTime++;
+/**
+ * @brief Set a random palette for the background and sprites.
+ *
+ */
+void SetRandomPalette()
+{
+    // FLASH_PALETTE_COUNT is a power of 2
+    uint8_t i = rand() & (FLASH_PALETTE_COUNT - 1);
 
-    if (state->curTime % state->timer == 0) scroll_win(0, -state->speed);
-    return TRUE;
+    SetBkgPalette(flashBkgPalettes[i]);
+    SetSpritePalette(flashSpritePalettes[i]);
 }
 
-BOOLEAN UpdateBlinkingStartTextState(BlinkingStartTextState* state)
+/**
+ * @brief Run a keyframe action.
+ *
+ * @param action the action (one of TIMELINE_ACTIONS, except END and JUMP)
+ * @param arg the argument of the action
+ */
+void RunAction(uint8_t action, uint8_t arg)
 {
-    if (state->curTime == 0) {
-        if (state->isVisibleAtStart)
-            ShowStartText();
-        else
-            HideStartText();
+    switch (action) {
+        case ACTION_BRIGHTNESS: SetBrightness(arg); break;
+        case ACTION_BRIGHTEN:
+            SetBrightness(brightness + arg < BKG_BRIGHTNESS_MAX
+                              ? brightness + arg
+                              : BKG_BRIGHTNESS_MAX);
+            break;
+        case ACTION_DARKEN:
+            SetBrightness(brightness > arg ? brightness - arg : 0);
+            break;
+        case ACTION_WIPE_OUT: WipeOut(arg); break;
+        case ACTION_RANDOM_PALETTE: SetRandomPalette(); break;
+        case ACTION_DEFAULT_PALETTE: SetDefaultPalette(); break;
+        case ACTION_SNAKE_FRAME: DisplaySnakeSprite(arg); break;
+        case ACTION_SHOW_START_TEXT: ShowStartText(); break;
+        case ACTION_HIDE_START_TEXT: HideStartText(); break;
+        case ACTION_RAISE_WIN: RaiseWin(arg); break;
+        default: break;
     }
-    else if (state->curTime >= state->startDelay &&
-             (state->curTime - state->startDelay) % state->timer == 0) {
-        if (state->isVisibleAtStart)
-            ShowStartText();
-        else
-            HideStartText();
+}
+
+/**
+ * @brief Make a keyframe the next one to run on a track.
+ *
+ * @param track a pointer to a valid Track
+ * @param keyframe the keyframe
+ */
+void EnterKeyframe(Track* track, const Keyframe* keyframe)
+{
+    track->keyframe = keyframe;
+    track->count = keyframe->count;
+}
+
+/**
+ * @brief Run the keyframes of a track until one has to wait or the track
+ * ends.
+ *
+ * @param track a pointer to a playing Track whose timer is 0
+ */
+void RunTrack(Track* track)
+{
+    while (track->timer == 0) {
+        const Keyframe* keyframe = track->keyframe;
+
+        if (keyframe->action == ACTION_END) {
+            track->keyframe = NULL;
+            return;
+        }
+
+        if (keyframe->action == ACTION_JUMP) {
+            EnterKeyframe(track, track->keyframes + keyframe->arg);
+            continue;
+        }
 
-        state->isVisibleAtStart = (state->isVisibleAtStart) ? FALSE : TRUE;
+        RunAction(keyframe->action, keyframe->arg);
+
+        track->timer = keyframe->wait;
+        if (--track->count == 0) EnterKeyframe(track, keyframe + 1);
     }
+}
+
+/*************************************************
+**               public functions               **
+*************************************************/
+
+void ShowMenuBkg()
+{
+    AcquireScreenTiles(&menuTileSet);
 
-    state->curTime++;
+    Unpacker unpacker;
+    StartUnpack(&unpacker, BANK(sets_packed), sets_menu_map_packed);
+    Unpack(&unpacker, menuTiles, sizeof(menuTiles));
+    MapTileSlots(menuTiles, sizeof(menuTiles));
 
-    return TRUE;
+    // the board stays in view while the menu is copied
+    isBkgPending = TRUE;
+    QueueMapTransfer(0, 0, sets_MAP_WIDTH, sets_menu_MAP_HEIGHT, MENU_MAP,
+                     menuTiles, sets_MAP_WIDTH, ShowMenuMap);
+    SHOW_BKG;
 }
 
-BOOLEAN UpdateSnakeAnimState(SnakeAnimState* state)
+void ShowBoardBkg(uint8_t width, uint8_t height, uint8_t x, uint8_t y)
 {
-    // finish if anim not looping and all frames are shown
-    if (!state->isLoop && state->curTime >= state->timer * (SNAKE_FRAME_COUNT +
-                                                            state->startDelay))
-        return FALSE;
+    camera.width = width;
+    camera.height = height;
+    camera.maxX = (width - BOARD_VIEW_WIDTH) << 3;
+    camera.maxY = (height - BOARD_VIEW_HEIGHT) << 3;
+    camera.x = CameraTarget(x, camera.maxX, BOARD_VIEW_WIDTH);
+    camera.y = CameraTarget(y, camera.maxY, BOARD_VIEW_HEIGHT);
+
+    AcquireScreenTiles(&boardTileSet);
+    MapTileSlots(boardBkgMap, POSITION_COUNT);
+
+    // only the tiles in view, the camera streams the others
+    uint8_t column = camera.x >> 3;
+    uint8_t row = camera.y >> 3;
+    uint8_t count = width - column;
+    if (count > LOADED_COLUMNS) count = LOADED_COLUMNS;
+
+    uint8_t rowCount = height - row;
+    if (rowCount > LOADED_ROWS) rowCount = LOADED_ROWS;
+
+    // the menu stays in view while the board is copied, the camera waits
+    isStripPending = FALSE;
+    isBkgPending = TRUE;
+    QueueMapTransfer(column, row, count, rowCount, BOARD_MAP,
+                     &boardBkgMap[PACK_POSITION(column, row)], BOARD_STRIDE,
+                     ShowBoardMap);
+    SHOW_BKG;
+}
 
-    if (state->curTime % state->timer == 0) {
-        // frame helps to deal with the "wait between loop"
-        uint8_t frame = state->curFrame;
+void FollowBoardCamera(uint8_t x, uint8_t y)
+{
+    // the camera waits for the board and for the strip it revealed
+    if (isBkgPending || isStripPending) return;
+
+    uint8_t nextX = StepCamera(
+        camera.x, CameraTarget(x, camera.maxX, BOARD_VIEW_WIDTH));
+    uint8_t nextY = StepCamera(
+        camera.y, CameraTarget(y, camera.maxY, BOARD_VIEW_HEIGHT));
+
+    // a new first column (or row) loads it when the camera moves back, and
+    // the one after the loaded ones when it moves forward. A single strip is
+    // streamed per frame, the other axis waits for the next frame.
+    if ((nextX >> 3) != (camera.x >> 3)) {
+        BOOLEAN isForward = nextX > camera.x;
+        camera.x = nextX;
+        PrepareColumn((nextX >> 3) + (isForward ? LOADED_COLUMNS - 1 : 0));
+    }
+    else if ((nextY >> 3) != (camera.y >> 3)) {
+        BOOLEAN isForward = nextY > camera.y;
+        camera.x = nextX;
+        camera.y = nextY;
+        PrepareRow((nextY >> 3) + (isForward ? LOADED_ROWS - 1 : 0));
+    }
+    else {
+        camera.x = nextX;
+        camera.y = nextY;
+    }
 
-        // if frame before startDelay or after SNAKE_FRAME_COUNT, frame -> 0
-        if (frame < state->startDelay)
-            frame = 0;
-        else
-            frame -= state->startDelay;
+    // the scroll and its strip are set at the same VBlank
+    disable_interrupts();
+    scrollX = camera.x;
+    scrollY = camera.y;
+    enable_interrupts();
+}
 
-        if (frame >= SNAKE_FRAME_COUNT) frame = 0;
+void ShowWin()
+{
+    // only the legend shows under the collapsed window, the other rows are
+    // written as the window rises
+    StartUnpack(&winUnpacker, BANK(sets_packed), sets_game_over_map_packed);
+    winRowCount = 0;
+    UnpackWinRows(1);
+    SHOW_WIN;
 
-        // display the corresponding snake
-        if (state->snakeId == AWAKE_SNAKE_ID)
-            DisplaySnakeSprite(frame);
-        else
-            DisplaySnakeSleepSprite(frame);
+    // the row overwrites the digits of the legend: they are queued again
+    // once the board fades in, after the row is copied
+    legendScore.shownBcd = NOT_SHOWN;
+    legendLevel.shownBcd = NOT_SHOWN;
+}
+
+void HideWin()
+{
+    HIDE_WIN;
+}
 
-        state->curFrame++;
+void ShowStartText()
+{
+    // set back the map of the "press start" row
+    uint8_t* row = &menuTiles[START_TEXT_ROW * sets_MAP_WIDTH];
 
-        if (state->curFrame >=
-            state->startDelay + SNAKE_FRAME_COUNT + state->waitBetweenLoop)
-            state->curFrame = 0;
-    }
+    Unpacker unpacker;
+    StartUnpack(&unpacker, BANK(sets_packed), sets_start_text_map_packed);
+    Unpack(&unpacker, row, sets_MAP_WIDTH * sets_start_text_MAP_HEIGHT);
+    MapTileSlots(row, sets_MAP_WIDTH * sets_start_text_MAP_HEIGHT);
+
+    // queued after the menu, so it is never copied over
+    QueueMapTransfer(0, START_TEXT_ROW, sets_MAP_WIDTH,
+                     sets_start_text_MAP_HEIGHT, MENU_MAP, row,
+                     sets_MAP_WIDTH, NULL);
+}
 
-    state->curTime++;
+void HideStartText()
+{
+    // replace every characters of "press start" to black (id=0)
+    uint8_t* text = &menuTiles[START_TEXT_ROW * sets_MAP_WIDTH + 4];
+    uint8_t black = GetTileSlot(0);
+    for (uint8_t i = 0; i < 12; i++) text[i] = black;
 
-    return TRUE;
+    QueueMapTransfer(4, START_TEXT_ROW, 12, 1, MENU_MAP, text,
+                     sets_MAP_WIDTH, NULL);
 }
 
-BOOLEAN UpdateFadeIn(FadeState* state)
+void ShowBoardSelect(uint8_t number)
 {
-    if (state->curTime > state->timer * BKG_BRIGHTNESS_MAX) return FALSE;
+    uint8_t* text =
+        &menuTiles[BOARD_SELECT_ROW * sets_MAP_WIDTH + BOARD_SELECT_COLUMN];
 
-    if (state->curTime % state->timer == 0) {
-        SetBrightness(state->curBrightness);
-        state->curBrightness++;
-    }
+    for (uint8_t i = 0; i < sizeof(boardSelectText); i++)
+        text[i] = GetTileSlot(boardSelectText[i]);
+    text[5] = GetTileSlot(0);
 
-    state->curTime++;
+    // at most 2 digits, counted without a divide
+    uint8_t tens = 0;
+    for (; number >= 10; number -= 10) tens++;
 
-    return TRUE;
+    text[6] = GetTileSlot(DIGIT_0_ORIGIN + tens);
+    text[7] = GetTileSlot(DIGIT_0_ORIGIN + number);
+
+    // queued after the menu, so it is never copied over
+    QueueMapTransfer(BOARD_SELECT_COLUMN, BOARD_SELECT_ROW,
+                     BOARD_SELECT_WIDTH, 1, MENU_MAP, text, sets_MAP_WIDTH,
+                     NULL);
 }
 
-BOOLEAN UpdateFadeOut(FadeState* state)
+void CollapseWin()
 {
-    if (state->curTime > state->timer * BKG_BRIGHTNESS_MAX) return FALSE;
+    move_win(7, HUD_LINE);
+}
 
-    if (state->curTime % state->timer == 0) {
-        SetBrightness(BKG_BRIGHTNESS_MAX - state->curBrightness);
-        state->curBrightness++;
-    }
+void ShowHudBand()
+{
+    SetPaletteSplit(HUD_LINE, HUD_BKG_PALETTE);
+}
 
-    state->curTime++;
+void HideHudBand()
+{
+    ClearPaletteSplit();
+}
 
-    return TRUE;
+void PlayTrack(uint8_t track, const Keyframe* keyframes)
+{
+    tracks[track].keyframes = keyframes;
+    tracks[track].timer = 0;
+    EnterKeyframe(&tracks[track], keyframes);
 }
 
-BOOLEAN UpdateFlash(FlashState* state)
+void StopTracks()
 {
-    if (state->curTime > state->duration) {
-        SetDefaultPalette();
-        return FALSE;
-    }
+    for (uint8_t i = 0; i < TRACK_COUNT; i++) tracks[i].keyframe = NULL;
+}
 
-    if (state->curTime % state->timer == 0) {
-        SetRandomPalette();
-    }
+BOOLEAN IsTrackPlaying(uint8_t track)
+{
+    return tracks[track].keyframe != NULL;
+}
+
+BOOLEAN UpdateTimeline()
+{
+    BOOLEAN isPlaying = FALSE;
+
+    for (uint8_t i = 0; i < TRACK_COUNT; i++) {
+        Track* track = &tracks[i];
+
+        if (track->keyframe == NULL) continue;
 
-    state->curTime++;
+        // most frames only count down
+        if (track->timer == 0 || --track->timer == 0) RunTrack(track);
+
+        if (track->keyframe != NULL) isPlaying = TRUE;
+    }
 
-    return TRUE;
+    return isPlaying;
 }
 
 void ShowSnakeSprite()
@@ -361,62 +1112,113 @@ void HideSnakeSprite()
 
 void MoveSnakeSprite(uint8_t x, uint8_t y)
 {
-    move_sprite(0, x, y);
-    move_sprite(1, x + 8, y);
-    move_sprite(2, x, y + 8);
-    move_sprite(3, x + 8, y + 8);
+    MoveSpriteObject(SNAKE_OBJECT, x, y);
 }
 
 void ScrollSnakeSprite(int8_t x, int8_t y)
 {
-    scroll_sprite(0, x, y);
-    scroll_sprite(1, x, y);
-    scroll_sprite(2, x, y);
-    scroll_sprite(3, x, y);
+    ScrollSpriteObject(SNAKE_OBJECT, x, y);
 }
 
-BoardCell GetBoardCell(uint8_t x, uint8_t y)
+BOOLEAN IsBkgPending()
 {
-    BoardCell cell = get_bkg_tile_xy(x, y);
-
-    // WALL_CELL is the index of the first wall tile. But there are
-    // multiple wall tiles. Every tile after WALL_CELL will be considered
-    // as a wallcheck. Check the first row of sets.bkg.png for more info.
-    if (cell > WALL_CELL) cell = WALL_CELL;
+    return isBkgPending;
+}
 
-    return cell;
+uint8_t* GetBoardBkgMap()
+{
+    return boardBkgMap;
 }
 
 void SetBoardCell(uint8_t x, uint8_t y, BoardCell cell)
 {
-    set_bkg_tile_xy(x, y, cell);
+    uint8_t tile = GetTileSlot(cell);
+    boardBkgMap[PACK_POSITION(x, y)] = tile;
+
+    // the other tiles are streamed once the camera reveals them
+    if (IsCellLoaded(x, y)) QueueTile(x, y, tile, FALSE);
 }
 
-void SetLegendScore(uint8_t score)
+void LoadSnakeSheet(uint8_t sheet)
 {
-    set_win_tile_xy(9, 0, DIGIT_0_ORIGIN + (score % 10));
-    score /= 10;
-    set_win_tile_xy(8, 0, DIGIT_0_ORIGIN + (score % 10));
-    score /= 10;
-    set_win_tile_xy(7, 0, DIGIT_0_ORIGIN + (score % 10));
+    if (sheet == snakeSheet) return;
+    snakeSheet = sheet;
+
+    // both sheets use the same sprite tiles
+    if (sheet == SNAKE_AWAKE_SHEET)
+        UnpackSpriteData(0, snake_TILE_COUNT, BANK(snake_packed),
+                         snake_tiles_packed);
+    else
+        UnpackSpriteData(0, snake_sleep_TILE_COUNT, BANK(snake_sleep_packed),
+                         snake_sleep_tiles_packed);
+}
+
+void SetLegendScore(uint16_t score)
+{
+    SetLegendCounter(&legendScore, score, 7, SCORE_DIGITS);
 }
 
 void SetLegendLevel(uint8_t level)
 {
-    set_win_tile_xy(17, 0, DIGIT_0_ORIGIN + (level / 10));
-    set_win_tile_xy(18, 0, DIGIT_0_ORIGIN + (level % 10));
+    SetLegendCounter(&legendLevel, level, 17, LEVEL_DIGITS);
+}
+
+void FlushTiles()
+{
+    uint8_t budget = TILE_FLUSH_BUDGET;
+
+    // a run is never longer than the budget, so every flush writes one
+    while (runIndex < runCount && tileRuns[runIndex].length <= budget) {
+        TileRun* run = &tileRuns[runIndex++];
+        const uint8_t* tiles = queuedTiles + run->offset;
+
+        if (run->isWin)
+            set_win_tiles(run->x, run->y, run->length, 1, tiles);
+        else
+            set_tiles(run->x, run->y, run->length, 1, BOARD_MAP, tiles);
+
+        budget -= run->length;
+    }
+
+    // the queue restarts from the beginning once everything is written
+    if (runIndex == runCount) {
+        runIndex = 0;
+        runCount = 0;
+        tileCount = 0;
+    }
 }
 
 void InitGraphics()
 {
-    set_bkg_data(0, sets_TILE_COUNT, sets_tiles);
+    // the first VBlank handler, so the tiles are written at the start of the
+    // VBlank
+    disable_interrupts();
+    add_VBL(RefreshScreen);
+
+    // the palette split uses the LYC interrupt, it never matches until a
+    // split is set
+    LYC_REG = NO_SPLIT;
+    STAT_REG = STATF_LYC;
+    add_LCD(ApplySplitPalette);
+    set_interrupts(IE_REG | LCD_IFLAG);
+
+    enable_interrupts();
+
+    // the transfers use the time the handlers above leave
+    InitTransfers();
+
+    // the window always uses the map of the menu
+    LCDC_REG |= LCDCF_WIN9C00;
 
-    set_sprite_data(0, snake_TILE_COUNT, snake_tiles);
-    set_sprite_data(snake_TILE_COUNT, snake_sleep_TILE_COUNT,
-                    snake_sleep_tiles);
+    // the tiles are loaded by the screens that show them
+    InitTileSlots();
+    screenTileSet = NULL;
+    snakeSheet = NO_SNAKE_SHEET;
 
+    SetSpriteObject(SNAKE_OBJECT, &snakeMetasprite, 0);
     SHOW_SPRITES;
 
-    SetDefaultPalette();
+    // nothing is loaded yet, the first screen fades in from black
+    SetBrightness(0);
     initrand(DIV_REG);
 }
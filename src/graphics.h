@@ -12,126 +12,88 @@
 #include <stdint.h>
 #include <types.h>
 
+#include "engine.h"
+
 #ifndef GRAPHICS_H
 #define GRAPHICS_H
 
-#define BKG_BRIGHTNESS_MAX 3
+/** the last fade step (the default palettes), see scripts/palettes.py */
+#define BKG_BRIGHTNESS_MAX 12
 
-#define AWAKE_SNAKE_ID     0
-#define SLEEPING_SNAKE_ID  1
+/**
+ * @defgroup TIMELINE_ACTIONS Timeline actions
+ *
+ * @brief the actions a keyframe runs (see Keyframe)
+ * @{
+ */
+#define ACTION_END             0 /**< stop the track */
+#define ACTION_JUMP            1 /**< go to the keyframe arg of the track */
+#define ACTION_WAIT            2 /**< do nothing */
+#define ACTION_BRIGHTNESS      3 /**< set the brightness to arg */
+#define ACTION_RANDOM_PALETTE  4 /**< set a random palette */
+#define ACTION_DEFAULT_PALETTE 5 /**< set the default palette */
+#define ACTION_SNAKE_FRAME     6 /**< show the frame arg of the snake sheet */
+#define ACTION_SHOW_START_TEXT 7 /**< show "press START" */
+#define ACTION_HIDE_START_TEXT 8 /**< hide "press START" */
+#define ACTION_RAISE_WIN       9 /**< raise the window and the snake by arg */
+#define ACTION_BRIGHTEN        10 /**< add arg fade steps */
+#define ACTION_DARKEN          11 /**< remove arg fade steps */
+#define ACTION_WIPE_OUT        12 /**< move a black wipe arg lines down */
+/** @} */
 
-/** \enum BoardCell
- * \brief Represent a cell within the game board.
+/**
+ * @defgroup TIMELINE_TRACKS Timeline tracks
  *
- *  See the first tile row of sets.bkg.png to have more info about the order.
+ * @brief the tracks that play in parallel, one per kind of effect
+ * @{
  */
-typedef enum {
-    EMPTY_CELL = 1,
-    SNAKE_CELL,
-    LOOT_CELL,
-    WALL_CELL
-} BoardCell;
+#define PALETTE_TRACK 0
+#define SPRITE_TRACK  1
+#define MAP_TRACK     2
+#define TRACK_COUNT   3
+/** @} */
 
-/** @struct BlinkingStartTextState
- *  Represent a state of the blinking "press START" text from the menu screen.
- *
- *  @var BlinkingStartTextState::timer
- *    The timer that loops and that triggers the blinking every time it
- *    reaches 0
- *  @var BlinkingStartTextState::isVisibleAtStart
- *    True if "press START" is visible before any blinking
- *  @var BlinkingStartTextState::startDelay
- *    The delay before the first blinking
- *  @var BlinkingStartTextState::curTime
- *    The number of time this state has been updated from start
- */
-typedef struct {
-    uint8_t timer;
-    BOOLEAN isVisibleAtStart;
-    uint8_t startDelay;
-    uint8_t curTime;
-} BlinkingStartTextState;
-
-/** @struct ExpandWinState
- *  Represent a state of the expansion of the window with the score and
- *  Game Over text.
- *
- *  @var ExpandWinState::timer
- *    The timer that loops and that triggers the expand every time it
- *    reaches 0
- *  @var ExpandWinState::speed
- *    The number of pixel the window expands for every update.
- *  @var ExpandWinState::curTime
- *    The number of time this state has been updated from start
- */
-typedef struct {
-    uint8_t timer;
-    uint8_t speed;
-    uint8_t curTime;
-} ExpandWinState;
-
-/** @struct FadeState
- *  Represent a state of a screen fading (in or out).
- *
- *  @var FadeState::timer
- *    The timer that loops and that triggers the fade every time it
- *    reaches 0
- *  @var FadeState::curBrightness
- *    The current brightness of the screen (0 to BKG_BRIGHTNESS_MAX)
- *  @var FadeState::curTime
- *    The number of time this state has been updated from start
- */
-typedef struct {
-    uint8_t timer;
-    uint8_t curBrightness;
-    uint8_t curTime;
-} FadeState;
-
-/** @struct FlashState
- *  Represent a state of a screen flashing.
- *
- *  @var FlashState::timer
- *    The timer that loops and that triggers a flash every time it
- *    reaches 0
- *  @var FlashState::duration
- *    The duration of the flash
- *  @var FlashState::curTime
- *    The number of time this state has been updated from start
- */
-typedef struct {
-    uint8_t timer;
-    uint8_t duration;
-    uint8_t curTime;
-} FlashState;
-
-/** @struct SnakeAnimState
- *  Represent a state of an animation of a snalke (AWAKE or SLEEPING)
- *
- *  @var SnakeAnimState::timer
- *    The timer that loops and that triggers a new frame every time it
- *    reaches 0
- *  @var SnakeAnimState::isLoop
- *    True of the animation loops
- *  @var BlinkingStartTextState::startDelay
- *    The delay before the first frame update
- *  @var SnakeAnimState::waitBetweenLoop
- *    The delay between two different loops (if isLoop = true)
- *  @var SnakeAnimState::snakeId
- *    The id of the snake to animate (AWAKE_SNAKE_ID or SLEEPING_SNAKE_ID)
- *  @var SnakeAnimState::curTime
- *    The number of time this state has been updated from start
- *  @var SnakeAnimState::curFrame
- *    The number of frame already displayed (including wait and delay frames)
+/**
+ * @defgroup SNAKE_SHEETS Snake sheets
+ *
+ * @brief the animations of the snake, loaded one at a time in the same
+ * sprite tiles (see LoadSnakeSheet), so ACTION_SNAKE_FRAME shows the frames
+ * of the loaded one
+ * @{
+ */
+#define SNAKE_AWAKE_SHEET 0 /**< the awake snake of the menu */
+#define SNAKE_SLEEP_SHEET 1 /**< the sleeping snake of the game over */
+/** @} */
+
+/** a keyframe that runs once and waits */
+#define KEYFRAME(action, arg, wait) {action, arg, wait, 1}
+/** a keyframe that runs count times, waiting after each run */
+#define REPEAT_KEYFRAME(action, arg, wait, count) {action, arg, wait, count}
+/** the keyframe that continues the track at another keyframe */
+#define JUMP_KEYFRAME(index) {ACTION_JUMP, index, 0, 1}
+/** the last keyframe of a track that does not loop */
+#define END_KEYFRAME {ACTION_END, 0, 0, 1}
+
+/** @struct Keyframe
+ *  Represent a step of an animation track, stored in ROM tables ending with
+ *  END_KEYFRAME or JUMP_KEYFRAME.
+ *
+ *  @var Keyframe::action
+ *    The action to run (one of TIMELINE_ACTIONS)
+ *  @var Keyframe::arg
+ *    The argument of the action
+ *  @var Keyframe::wait
+ *    The number of frames after every run, 0 runs the next keyframe at once
+ *    (a loop must wait somewhere)
+ *  @var Keyframe::count
+ *    The number of runs (at least 1)
  */
 typedef struct {
-    uint8_t timer;
-    BOOLEAN isLoop;
-    uint8_t startDelay;
-    uint8_t waitBetweenLoop;
-    uint8_t snakeId;
-    uint8_t curTime;
-    uint8_t curFrame;
-} SnakeAnimState;
+    uint8_t action;
+    uint8_t arg;
+    uint8_t wait;
+    uint8_t count;
+} Keyframe;
 
 /**
  * @brief Initialize the graphics. Must be called before any other graphics
@@ -141,19 +103,50 @@ typedef struct {
 void InitGraphics();
 
 /**
- * @brief Show the menu to the screen as background
+ * @brief Show the menu to the screen as background. It is copied to its own
+ * map by the transfers while the current screen stays in view, and shows
+ * once copied (see IsBkgPending).
  *
  */
 void ShowMenuBkg();
 
 /**
- * @brief Show the board to the screen as background
+ * @brief Show the board to the screen as background, with the camera on a
+ * cell. Only the tiles in view are written, see FollowBoardCamera. They are
+ * copied to the map of the board by the transfers while the current screen
+ * stays in view, and show once copied (see IsBkgPending).
  *
+ * @param width the width of the board (from the width of the screen)
+ * @param height the height of the board (from the height of the screen
+ * above the legend)
+ * @param x the x position of the cell
+ * @param y the y position of the cell
  */
-void ShowBoardBkg();
+void ShowBoardBkg(uint8_t width, uint8_t height, uint8_t x, uint8_t y);
 
 /**
- * @brief Show the window (layer with the scores and game over text)
+ * @brief Move the camera toward a cell (the snake head) on a board larger
+ * than the screen, at most a few pixels per frame. The row or column of
+ * tiles it reveals is written at the next VBlank, with the new scroll. Must
+ * be called once per frame.
+ *
+ * @param x the x position of the cell
+ * @param y the y position of the cell
+ */
+void FollowBoardCamera(uint8_t x, uint8_t y);
+
+/**
+ * @brief Get whether the screen asked by ShowMenuBkg or ShowBoardBkg is not
+ * shown yet.
+ *
+ * @return true while the screen is being copied
+ */
+BOOLEAN IsBkgPending();
+
+/**
+ * @brief Show the window (layer with the scores and game over text). Only
+ * the legend row is written, the game over rows are written as
+ * ACTION_RAISE_WIN reveals them.
  *
  */
 void ShowWin();
@@ -171,6 +164,19 @@ void HideWin();
  */
 void CollapseWin();
 
+/**
+ * @brief Draw the legend band (the collapsed window) with its own palette,
+ * changed at its first line by the LCD interrupt.
+ *
+ */
+void ShowHudBand();
+
+/**
+ * @brief Draw the whole screen with the same palette again.
+ *
+ */
+void HideHudBand();
+
 /**
  * @brief Show the "press START" text at the menu screen
  *
@@ -183,6 +189,13 @@ void ShowStartText();
  */
 void HideStartText();
 
+/**
+ * @brief Show the board the next game is played on at the menu screen
+ *
+ * @param number the number of the board (from 1, up to 99)
+ */
+void ShowBoardSelect(uint8_t number);
+
 /**
  * @brief Show the snake sprite (according to the snake id that was
  * previously set).
@@ -197,7 +210,8 @@ void ShowSnakeSprite();
 void HideSnakeSprite();
 
 /**
- * @brief Scroll the snake sprite to relative x and y positions
+ * @brief Scroll the snake sprite to relative x and y positions. Like every
+ * sprite change, it is shown after the next UpdateSprites.
  *
  * @param x the relative x position to scroll
  * @param y the relative y position to scroll
@@ -213,16 +227,25 @@ void ScrollSnakeSprite(int8_t x, int8_t y);
 void MoveSnakeSprite(uint8_t x, uint8_t y);
 
 /**
- * @brief Get the board cell at the given (x,y) position
+ * @brief Load a sheet of the snake in the sprite tiles, unless it is already
+ * loaded. The snake must be hidden (or the screen black) while it loads.
  *
- * @param x the x position
- * @param y the y position
- * @return the board cell at the (x,y) position
+ * @param sheet the sheet to load (see SNAKE_SHEETS)
+ */
+void LoadSnakeSheet(uint8_t sheet);
+
+/**
+ * @brief Get the tiles of the board background (in WRAM) indexed by packed
+ * position (POSITION_COUNT tiles). Set by InitEngine before ShowBoardBkg.
+ *
+ * @return a pointer to the first tile of the board
  */
-BoardCell GetBoardCell(uint8_t x, uint8_t y);
+uint8_t* GetBoardBkgMap();
 
 /**
  * @brief Set the given board cell at the given (x,y) position of the board.
+ * The tile is queued and written at the next VBlank if it is in view, else
+ * it is written once the camera reveals it.
  *
  * @param x the x position
  * @param y the y position
@@ -231,132 +254,59 @@ BoardCell GetBoardCell(uint8_t x, uint8_t y);
 void SetBoardCell(uint8_t x, uint8_t y, BoardCell cell);
 
 /**
- * @brief Set the value of the score within the legend
+ * @brief Set the value of the score within the legend. Only the digits that
+ * changed are queued (like the board cells).
  *
- * @param score the score value to set
+ * @param score the score value to set (up to 999)
  */
-void SetLegendScore(uint8_t score);
+void SetLegendScore(uint16_t score);
 
 /**
- * @brief Set the value of the level within the legend
+ * @brief Set the value of the level within the legend. Only the digits that
+ * changed are queued (like the board cells).
  *
- * @param level the level value to set
+ * @param level the level value to set (up to 99)
  */
 void SetLegendLevel(uint8_t level);
 
 /**
- * @brief Create a FadeState struct and initialize it with the given arguments.
- *
- * @param timer the timer to set within the new FadeState struct
- * @return the newly created FadeState struct
- */
-FadeState CreateFadeState(uint8_t timer);
-
-/**
- * @brief Create a FlashState struct and initialize it with the given
- * arguments.
- *
- * @param timer the timer to set
- * @param duration the duration to set
- * @return the newly created FlashState struct
- */
-FlashState CreateFlashState(uint8_t timer, uint8_t duration);
-
-/**
- * @brief Create an ExpandWinState struct and initialize it with the given
- * arguments.
- *
- * @param timer the timer to set
- * @param speed the speed to set
- * @return the newly created ExpandWinState struct
- */
-ExpandWinState CreateExpandWinState(uint8_t timer, uint8_t speed);
-
-/**
- * @brief Create a SnakeAnimState struct and initialize it with the given
- * arguments.
- *
- * @param timer the timer to set
- * @param isLoop true of the animation loops
- * @param startDelay the delay before the first frame update
- * @param waitBetweenLoop the delay between two different loops (if isLoop =
- * true)
- * @param snakeId the id of the snake to animate (AWAKE_SNAKE_ID or
- * SLEEPING_SNAKE_ID)
- * @return the newly created SnakeAnimState struct
- */
-SnakeAnimState CreateSnakeAnimState(uint8_t timer, BOOLEAN isLoop,
-                                    uint8_t startDelay,
-                                    uint8_t waitBetweenLoop, uint8_t snakeId);
-
-/**
- * @brief Create a BlinkingStartTextState struct and initialize it with the
- * given arguments.
- *
- * @param timer the timer to set
- * @param isVisibleAtStart true if "press START" is visible before any blinking
- * @param startDelay the delay before the first blinking
- * @return the newly created BlinkingStartTextState struct
- */
-BlinkingStartTextState CreateBlinkingStartTextState(uint8_t timer,
-                                                    BOOLEAN isVisibleAtStart,
-                                                    int8_t startDelay);
-
-/**
- * @brief Update the given FadeState struct and fade in the screen accordingly.
- *
- * @param state the structure storing the state of the fade in.
- * @return True if fade in was applied to the screen. False if the screen was
- * already at max brightness (BKG_BRIGHTNESS_MAX)
- */
-BOOLEAN UpdateFadeIn(FadeState* state);
-
-/**
- * @brief Update the given FadeState struct and fade out the screen
- * accordingly.
+ * @brief Write the queued tiles to the maps, at most TILE_FLUSH_BUDGET tiles
+ * so the writes fit in the VBlank. The remaining tiles are written at the next
+ * calls. It is called by the VBlank handler registered by InitGraphics.
  *
- * @param state the structure storing the state of the fade out.
- * @return True if fade out was applied to the screen. False if the screen was
- * already at lower brightness (0)
  */
-BOOLEAN UpdateFadeOut(FadeState* state);
+void FlushTiles();
 
 /**
- * @brief Update the given FlashState struct and apply a flash accordingly.
+ * @brief Play keyframes on a track, from the first one, replacing the
+ * keyframes that the track was playing. The first keyframe runs at the next
+ * UpdateTimeline.
  *
- * @param state the structure storing the state of the flash effect.
- * @return True if a flash effect was applied to the screen. False if the
- * effect is over.
+ * @param track the track (one of TIMELINE_TRACKS)
+ * @param keyframes the keyframe table
  */
-BOOLEAN UpdateFlash(FlashState* state);
+void PlayTrack(uint8_t track, const Keyframe* keyframes);
 
 /**
- * @brief Update the given ExpandWinState struct and expand the window
- * accordingly.
+ * @brief Stop every track.
  *
- * @param state the structure storing the state of the window expansion.
- * @return True if the window was still expanding. False if the window was
- * already fully expanded.
  */
-BOOLEAN UpdateExpandWin(ExpandWinState* state);
+void StopTracks();
 
 /**
- * @brief Update the given SnakeAnimState struct and update the frame
- * accordingly.
+ * @brief Check if a track is playing.
  *
- * @param state the structure storing the state of the snake animation.
- * @return True if the frame has been updated. False otherwise.
+ * @param track the track (one of TIMELINE_TRACKS)
+ * @return True if the track has not reached its END_KEYFRAME
  */
-BOOLEAN UpdateSnakeAnimState(SnakeAnimState* state);
+BOOLEAN IsTrackPlaying(uint8_t track);
 
 /**
- * @brief Update the given BlinkingStartTextState struct and update the
- * "press Start" text visibility accordingly.
+ * @brief Advance every track by a frame and run their due keyframes. To call
+ * once per frame.
  *
- * @param state the structure storing the state of the blinking effect.
- * @return True if a blinking effect was applied to the screen. False if the
- * effect is over.
+ * @return True if a track is still playing. False if all of them are over.
  */
-BOOLEAN UpdateBlinkingStartTextState(BlinkingStartTextState* state);
+BOOLEAN UpdateTimeline();
 
 #endif
\ No newline at end of file
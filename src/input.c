@@ -0,0 +1,70 @@
+#include "input.h"
+
+/*************************************************
+**               private variables              **
+*************************************************/
+
+/** written by the VBlank interrupt */
+volatile uint8_t inputKeys;
+volatile uint8_t pressedKeys;
+volatile uint8_t releasedKeys;
+
+/*************************************************
+**             private functions                **
+*************************************************/
+
+/**
+ * @brief Read the joypad and add its edges to the pressed and released
+ * keys (VBlank handler).
+ *
+ */
+void LatchInput()
+{
+    uint8_t keys = joypad();
+
+    pressedKeys |= keys & ~inputKeys;
+    releasedKeys |= inputKeys & ~keys;
+    inputKeys = keys;
+}
+
+/*************************************************
+**               public functions               **
+*************************************************/
+
+void InitInput()
+{
+    disable_interrupts();
+
+    inputKeys = 0;
+    pressedKeys = 0;
+    releasedKeys = 0;
+    add_VBL(LatchInput);
+
+    enable_interrupts();
+}
+
+uint8_t GetInputKeys()
+{
+    return inputKeys;
+}
+
+uint8_t TakePressedKeys()
+{
+    // the VBlank must not add a key between the read and the clear
+    disable_interrupts();
+    uint8_t keys = pressedKeys;
+    pressedKeys = 0;
+    enable_interrupts();
+
+    return keys;
+}
+
+uint8_t TakeReleasedKeys()
+{
+    disable_interrupts();
+    uint8_t keys = releasedKeys;
+    releasedKeys = 0;
+    enable_interrupts();
+
+    return keys;
+}
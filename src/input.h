@@ -0,0 +1,48 @@
+/**
+ * @file input.h
+ * @author Raphael Jouretz (rjouretz.com)
+ * @brief Read the joypad once per frame, in the VBlank interrupt, and keep
+ * the pressed and released keys until they are taken
+ * @version 0.1
+ * @date 2023-06-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <gb/gb.h>
+#include <stdint.h>
+#include <types.h>
+
+#ifndef INPUT_H
+#define INPUT_H
+
+/**
+ * @brief Start to read the joypad on every VBlank. Must be called once the
+ * VBlank interrupt is enabled (see InitSoundPlayer).
+ *
+ */
+void InitInput();
+
+/**
+ * @brief Get the keys held at the last VBlank.
+ *
+ * @return the joypad state (J_* flags)
+ */
+uint8_t GetInputKeys();
+
+/**
+ * @brief Get the keys pressed since the last call. A key pressed and
+ * released between two calls is still returned once.
+ *
+ * @return the pressed keys (J_* flags)
+ */
+uint8_t TakePressedKeys();
+
+/**
+ * @brief Get the keys released since the last call.
+ *
+ * @return the released keys (J_* flags)
+ */
+uint8_t TakeReleasedKeys();
+
+#endif
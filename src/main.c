@@ -12,6 +12,7 @@
 #include "board.h"
 #include "gameover.h"
 #include "graphics.h"
+#include "input.h"
 #include "menu.h"
 #include "sound.h"
 #include "utils.h"
@@ -24,6 +25,8 @@ void InitGameBoy()
 {
     InitSoundPlayer();
     InitGraphics();
+    InitFrameScheduler();
+    InitInput();
 }
 
 /**
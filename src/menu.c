@@ -1,61 +1,102 @@
 #include "menu.h"
 
+#include <resources/levels.h>
 #include <types.h>
 
+#include "board.h"
 #include "graphics.h"
+#include "input.h"
 #include "sound.h"
+#include "sprites.h"
 #include "utils.h"
 
+/*************************************************
+**               private variables              **
+*************************************************/
+
+/** the brightness rises every 2 frames */
+const Keyframe menuFadeIn[] = {
+    KEYFRAME(ACTION_BRIGHTNESS, 0, 2),
+    REPEAT_KEYFRAME(ACTION_BRIGHTEN, 1, 2, BKG_BRIGHTNESS_MAX), END_KEYFRAME};
+
+/** the screen is wiped to black from the top, 8 lines per frame */
+const Keyframe menuWipeOut[] = {REPEAT_KEYFRAME(ACTION_WIPE_OUT, 8, 1, 18),
+                                KEYFRAME(ACTION_BRIGHTNESS, 0, 1),
+                                END_KEYFRAME};
+
+/** the snake rests, then plays its 10 frames every 8 frames, and loops */
+const Keyframe menuSnake[] = {
+    KEYFRAME(ACTION_SNAKE_FRAME, 0, 104), KEYFRAME(ACTION_SNAKE_FRAME, 1, 8),
+    KEYFRAME(ACTION_SNAKE_FRAME, 2, 8),   KEYFRAME(ACTION_SNAKE_FRAME, 3, 8),
+    KEYFRAME(ACTION_SNAKE_FRAME, 4, 8),   KEYFRAME(ACTION_SNAKE_FRAME, 5, 8),
+    KEYFRAME(ACTION_SNAKE_FRAME, 6, 8),   KEYFRAME(ACTION_SNAKE_FRAME, 7, 8),
+    KEYFRAME(ACTION_SNAKE_FRAME, 8, 8),   KEYFRAME(ACTION_SNAKE_FRAME, 9, 8),
+    KEYFRAME(ACTION_SNAKE_FRAME, 0, 96),  JUMP_KEYFRAME(0)};
+
+/** "press START" is hidden, then blinks every 24 frames */
+const Keyframe menuStartText[] = {
+    KEYFRAME(ACTION_HIDE_START_TEXT, 0, 48),
+    KEYFRAME(ACTION_SHOW_START_TEXT, 0, 24),
+    KEYFRAME(ACTION_HIDE_START_TEXT, 0, 24), JUMP_KEYFRAME(1)};
+
+/*************************************************
+**               public functions               **
+*************************************************/
+
 void RunMenu()
 {
     /****  prepare  ****/
 
     ShowMenuBkg();
+    ShowBoardSelect(GetNextBoard() + 1);
+    LoadSnakeSheet(SNAKE_AWAKE_SHEET);
     MoveSnakeSprite(84, 34);
 
+    // the fade in starts once the menu is copied
+    while (IsBkgPending()) Delay(1);
+
     /****  play audio  ****/
 
     PlayMenuSound(TRUE);
 
-    /****  set animation states  ****/
+    /****  play animations  ****/
 
-    BOOLEAN isFadeIn = TRUE;
-    BOOLEAN isFadeOut = FALSE;
-    BOOLEAN isSnakeAnimated = TRUE;
     BOOLEAN isStartPressed = FALSE;
 
-    FadeState fadeState;
-    SnakeAnimState snakeAnimState;
-    BlinkingStartTextState blinkingStartTextState;
-
-    fadeState = CreateFadeState(6);
-    snakeAnimState = CreateSnakeAnimState(8, TRUE, 12, 12, AWAKE_SNAKE_ID);
-    blinkingStartTextState = CreateBlinkingStartTextState(24, FALSE, 24);
-
-    UpdateFadeIn(&fadeState);
+    PlayTrack(PALETTE_TRACK, menuFadeIn);
+    PlayTrack(SPRITE_TRACK, menuSnake);
+    PlayTrack(MAP_TRACK, menuStartText);
 
     /****  menu loop  ****/
 
     while (TRUE) {
-        // handle the joypad
-        if (joypad() & J_START) {
-            fadeState = CreateFadeState(6);
-            isFadeOut = TRUE;
+        // handle the joypad: a START held through the wipe out does not
+        // restart it
+        uint8_t keys = TakePressedKeys();
+
+        if (keys & J_START) {
+            PlayTrack(PALETTE_TRACK, menuWipeOut);
             isStartPressed = TRUE;
         }
-        // update the animations
-        if (isFadeIn) isFadeIn = UpdateFadeIn(&fadeState);
-
-        if (isSnakeAnimated)
-            isSnakeAnimated = UpdateSnakeAnimState(&snakeAnimState);
-
-        if (isFadeOut) {
-            isFadeOut = UpdateFadeOut(&fadeState);
-            // fade out finished -> quit menu
-            if (!isFadeOut && isStartPressed) break;
+        // LEFT and RIGHT select the board of the game, every board can be
+        // played from the menu
+        else if (!isStartPressed && (keys & (J_LEFT | J_RIGHT))) {
+            uint8_t board = GetNextBoard();
+
+            if (keys & J_RIGHT)
+                board = board + 1 == LEVEL_COUNT ? 0 : board + 1;
+            else
+                board = board ? board - 1 : LEVEL_COUNT - 1;
+
+            SetNextBoard(board);
+            ShowBoardSelect(board + 1);
         }
 
-        UpdateBlinkingStartTextState(&blinkingStartTextState);
+        UpdateTimeline();
+        UpdateSprites();
+
+        // wipe out finished -> quit menu
+        if (isStartPressed && !IsTrackPlaying(PALETTE_TRACK)) break;
 
         // update the sound
         UpdateSound();
@@ -63,4 +104,7 @@ void RunMenu()
         // delay to limit framerate
         Delay(1);
     }
+
+    // the snake and the text loop forever
+    StopTracks();
 }
\ No newline at end of file
@@ -0,0 +1,199 @@
+#include "replay.h"
+
+/** the size of the header (magic, version, seed and level) */
+#define HEADER_SIZE  6
+
+/** the size of the trailer (end byte, ticks, score and hash) */
+#define TRAILER_SIZE 9
+
+/** the version byte flag of a truncated replay */
+#define TRUNCATED_FLAG 0x80
+
+/** the run ticks value announcing 16 bits ticks */
+#define LONG_RUN 15
+
+/*************************************************
+**             private functions                **
+*************************************************/
+
+/**
+ * @brief Write a 16 bits little endian value
+ *
+ * @param data where to write
+ * @param value the value to write
+ */
+void WriteUint16(uint8_t* data, uint16_t value)
+{
+    data[0] = value & 0xFF;
+    data[1] = value >> 8;
+}
+
+/**
+ * @brief Read a 16 bits little endian value
+ *
+ * @param data where to read
+ * @return the read value
+ */
+uint16_t ReadUint16(const uint8_t* data)
+{
+    return data[0] | ((uint16_t)data[1] << 8);
+}
+
+/**
+ * @brief Hash the board cells of the given state (CRC-16-CCITT)
+ *
+ * @param state the state to hash
+ * @return the hash of the board
+ */
+uint16_t HashBoard(const EngineState* state)
+{
+    uint16_t crc = 0xFFFF;
+
+    for (uint16_t pos = 0; pos < POSITION_COUNT; pos++) {
+        crc ^= (uint16_t)state->cells[pos] << 8;
+        for (uint8_t i = 0; i < 8; i++)
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+
+    return crc;
+}
+
+/**
+ * @brief Write the current run of a replay being recorded
+ *
+ * @param replay a pointer to a Replay being recorded
+ */
+void FlushRun(Replay* replay)
+{
+    if (replay->run == 0 || replay->isTruncated) return;
+
+    uint8_t size = replay->run < LONG_RUN ? 1 : 3;
+
+    // the trailer space is always kept free
+    if (replay->size + size + TRAILER_SIZE > REPLAY_CAPACITY) {
+        replay->isTruncated = 1;
+        replay->data[2] |= TRUNCATED_FLAG;
+        return;
+    }
+
+    uint8_t* data = replay->data + replay->size;
+
+    if (size == 1)
+        data[0] = replay->input << 4 | replay->run;
+    else {
+        data[0] = replay->input << 4 | LONG_RUN;
+        WriteUint16(data + 1, replay->run);
+    }
+
+    replay->size += size;
+}
+
+/*************************************************
+**               public functions               **
+*************************************************/
+
+void StartReplayRecord(Replay* replay, uint8_t level, uint16_t seed)
+{
+    replay->data[0] = 'S';
+    replay->data[1] = 'R';
+    replay->data[2] = REPLAY_VERSION;
+    WriteUint16(replay->data + 3, seed);
+    replay->data[5] = level;
+
+    replay->size = HEADER_SIZE;
+    replay->input = 0;
+    replay->run = 0;
+    replay->ticks = 0;
+    replay->isTruncated = 0;
+}
+
+void RecordReplayInput(Replay* replay, uint8_t input)
+{
+    // the engine only reads the directions
+    input &= 0x0F;
+    replay->ticks++;
+
+    if (replay->run && input == replay->input && replay->run < 0xFFFF) {
+        replay->run++;
+        return;
+    }
+
+    FlushRun(replay);
+    replay->input = input;
+    replay->run = 1;
+}
+
+void FinishReplayRecord(Replay* replay, const EngineState* state)
+{
+    FlushRun(replay);
+    replay->run = 0;
+
+    uint8_t* data = replay->data + replay->size;
+
+    data[0] = 0;
+    WriteUint16(data + 1, replay->ticks & 0xFFFF);
+    WriteUint16(data + 3, replay->ticks >> 16);
+    WriteUint16(data + 5, state->score);
+    WriteUint16(data + 7, HashBoard(state));
+
+    replay->size += TRAILER_SIZE;
+}
+
+uint8_t StartReplayPlay(Replay* replay)
+{
+    replay->pos = HEADER_SIZE;
+    replay->run = 0;
+    replay->ticks = 0;
+    replay->isTruncated = (replay->data[2] & TRUNCATED_FLAG) != 0;
+
+    if (replay->size < HEADER_SIZE + TRAILER_SIZE) return 0;
+    if (replay->data[0] != 'S' || replay->data[1] != 'R') return 0;
+    if ((replay->data[2] & ~TRUNCATED_FLAG) != REPLAY_VERSION) return 0;
+
+    return !replay->isTruncated;
+}
+
+uint16_t GetReplaySeed(const Replay* replay)
+{
+    return ReadUint16(replay->data + 3);
+}
+
+uint8_t GetReplayLevel(const Replay* replay)
+{
+    return replay->data[5];
+}
+
+uint8_t NextReplayInput(Replay* replay, uint8_t* input)
+{
+    if (replay->run == 0) {
+        // the trailer is not a run
+        if (replay->pos + TRAILER_SIZE > replay->size) return 0;
+
+        uint8_t byte = replay->data[replay->pos];
+        if (byte == 0) return 0;
+
+        replay->input = byte >> 4;
+        replay->run = byte & 0x0F;
+        replay->pos++;
+
+        if (replay->run == LONG_RUN) {
+            replay->run = ReadUint16(replay->data + replay->pos);
+            replay->pos += 2;
+        }
+    }
+
+    replay->run--;
+    replay->ticks++;
+    *input = replay->input;
+    return 1;
+}
+
+uint8_t CheckReplay(const Replay* replay, const EngineState* state)
+{
+    const uint8_t* trailer = replay->data + replay->size - TRAILER_SIZE;
+    uint32_t ticks =
+        ReadUint16(trailer + 1) | ((uint32_t)ReadUint16(trailer + 3) << 16);
+
+    return replay->ticks == ticks && state->score == ReadUint16(trailer + 5) &&
+           HashBoard(state) == ReadUint16(trailer + 7);
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+/**
+ * @file replay.h
+ * @author Raphael Jouretz (rjouretz.com)
+ * @brief Record and play games as a seed and run length encoded inputs
+ * (no gb/gb.h, so the host can check the games recorded by the ROM)
+ * @version 0.1
+ * @date 2023-06-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * A replay is a sequence of bytes:
+ * - header: 'S', 'R', version (bit 7 set if truncated), seed (16 bits LE),
+ *   level (index in the levels table)
+ * - runs: (input << 4 | ticks) with ticks in [1, 14], or (input << 4 | 15)
+ *   followed by the ticks (16 bits LE). A 0 byte ends the runs.
+ * - trailer: ticks (32 bits LE), score (16 bits LE), board hash (16 bits LE)
+ */
+#include <stdint.h>
+
+#include "engine.h"
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+/** the size of the replay buffer (in bytes) */
+#ifndef REPLAY_CAPACITY
+#define REPLAY_CAPACITY 1024
+#endif
+
+/** the version of the replay format (2: the inputs are the pressed keys, 3:
+ * the speed table, 4: the 16 bits score, 5: the level, 6: the boards larger
+ * than the screen, 7: the speeds of the levels 1 to 7 of the frame timer, 8:
+ * the loots dropped on the n-th empty cell of the board) */
+#define REPLAY_VERSION 8
+
+/** @struct Replay
+ *  Represent a replay being recorded or played.
+ *
+ *  @var Replay::data
+ *    The bytes of the replay.
+ *  @var Replay::size
+ *    The number of bytes of the replay.
+ *  @var Replay::pos
+ *    The read position (when playing).
+ *  @var Replay::input
+ *    The input of the current run.
+ *  @var Replay::run
+ *    The ticks of the current run (recorded ticks when recording, remaining
+ *    ticks when playing).
+ *  @var Replay::ticks
+ *    The number of recorded (or played) ticks.
+ *  @var Replay::isTruncated
+ *    Non zero if the buffer was too small to record the whole game.
+ */
+typedef struct {
+    uint8_t data[REPLAY_CAPACITY];
+    uint16_t size;
+    uint16_t pos;
+    uint8_t input;
+    uint16_t run;
+    uint32_t ticks;
+    uint8_t isTruncated;
+} Replay;
+
+/**
+ * @brief Start the record of a new game.
+ *
+ * @param replay a pointer to a valid Replay
+ * @param level the index of the level given to InitEngine
+ * @param seed the seed given to InitEngine
+ */
+void StartReplayRecord(Replay* replay, uint8_t level, uint16_t seed);
+
+/**
+ * @brief Record the input of a tick. Must be called with the input given to
+ * every StepEngine call.
+ *
+ * @param replay a pointer to a Replay being recorded
+ * @param input the input of the tick
+ */
+void RecordReplayInput(Replay* replay, uint8_t input);
+
+/**
+ * @brief Finish the record with the final state of the game.
+ *
+ * @param replay a pointer to a Replay being recorded
+ * @param state the final state of the game
+ */
+void FinishReplayRecord(Replay* replay, const EngineState* state);
+
+/**
+ * @brief Start to play a replay whose data and size are set.
+ *
+ * @param replay a pointer to a valid Replay
+ * @return non zero if the replay is valid and complete
+ */
+uint8_t StartReplayPlay(Replay* replay);
+
+/**
+ * @brief Get the seed of a replay being played.
+ *
+ * @param replay a pointer to a Replay being played
+ * @return the seed to give to InitEngine
+ */
+uint16_t GetReplaySeed(const Replay* replay);
+
+/**
+ * @brief Get the level of a replay being played.
+ *
+ * @param replay a pointer to a Replay being played
+ * @return the index of the level to give to InitEngine
+ */
+uint8_t GetReplayLevel(const Replay* replay);
+
+/**
+ * @brief Get the input of the next tick.
+ *
+ * @param replay a pointer to a Replay being played
+ * @param input set to the input of the next tick
+ * @return non zero if there is a next tick, 0 at the end of the replay
+ */
+uint8_t NextReplayInput(Replay* replay, uint8_t* input);
+
+/**
+ * @brief Check that the final state of a played replay is the recorded one.
+ *
+ * @param replay a pointer to a Replay played to its end
+ * @param state the state after the last tick
+ * @return non zero if the ticks, the score and the board match
+ */
+uint8_t CheckReplay(const Replay* replay, const EngineState* state);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "sprites.h"
+
+/*************************************************
+**                  structures                  **
+*************************************************/
+
+/** @struct SpriteObject
+ *  Represent an animated metasprite and the shadow OAM entries it owns.
+ *
+ *  @var SpriteObject::metasprite
+ *    The layout of the object (NULL while the object is not set).
+ *  @var SpriteObject::oam
+ *    The first shadow OAM entry of the object.
+ *  @var SpriteObject::x
+ *    The x position of the object.
+ *  @var SpriteObject::y
+ *    The y position of the object.
+ *  @var SpriteObject::tile
+ *    The first tile of the current frame.
+ *  @var SpriteObject::isDirty
+ *    Whether the object changed since it was written to the shadow OAM.
+ */
+typedef struct {
+    const Metasprite* metasprite;
+    uint8_t oam;
+    uint8_t x;
+    uint8_t y;
+    uint8_t tile;
+    BOOLEAN isDirty;
+} SpriteObject;
+
+/*************************************************
+**               private variables              **
+*************************************************/
+
+SpriteObject spriteObjects[SPRITE_OBJECT_COUNT];
+
+/*************************************************
+**               public functions               **
+*************************************************/
+
+void SetSpriteObject(uint8_t object, const Metasprite* metasprite,
+                     uint8_t oam)
+{
+    spriteObjects[object].metasprite = metasprite;
+    spriteObjects[object].oam = oam;
+    spriteObjects[object].isDirty = TRUE;
+}
+
+void MoveSpriteObject(uint8_t object, uint8_t x, uint8_t y)
+{
+    spriteObjects[object].x = x;
+    spriteObjects[object].y = y;
+    spriteObjects[object].isDirty = TRUE;
+}
+
+void ScrollSpriteObject(uint8_t object, int8_t x, int8_t y)
+{
+    spriteObjects[object].x += x;
+    spriteObjects[object].y += y;
+    spriteObjects[object].isDirty = TRUE;
+}
+
+void SetSpriteObjectTile(uint8_t object, uint8_t tile)
+{
+    spriteObjects[object].tile = tile;
+    spriteObjects[object].isDirty = TRUE;
+}
+
+void UpdateSprites()
+{
+    SpriteObject* object = spriteObjects;
+
+    for (uint8_t i = SPRITE_OBJECT_COUNT; i; i--, object++) {
+        if (!object->isDirty || !object->metasprite) continue;
+        object->isDirty = FALSE;
+
+        // the parts are written straight to the shadow OAM, the DMA of the
+        // next VBlank copies every entry at once
+        const SpritePart* part = object->metasprite->parts;
+        volatile OAM_item_t* entry = &shadow_OAM[object->oam];
+
+        for (uint8_t j = object->metasprite->count; j; j--, part++, entry++) {
+            entry->y = object->y + part->dy;
+            entry->x = object->x + part->dx;
+            entry->tile = object->tile + part->tile;
+        }
+    }
+}
@@ -0,0 +1,105 @@
+/**
+ * @file sprites.h
+ * @author Raphael Jouretz (rjouretz.com)
+ * @brief Describe the multi-tile sprites (metasprites) as tables and write
+ * them to the shadow OAM, which GBDK copies to the OAM with a single DMA on
+ * every VBlank
+ * @version 0.1
+ * @date 2023-06-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <gb/gb.h>
+#include <stdint.h>
+#include <types.h>
+
+#ifndef SPRITES_H
+#define SPRITES_H
+
+/**
+ * @defgroup SPRITE_OBJECTS Sprite objects
+ *
+ * @brief the animated objects, each one owns the shadow OAM entries of its
+ * metasprite
+ * @{
+ */
+#define SNAKE_OBJECT        0
+#define SPRITE_OBJECT_COUNT 1
+/** @} */
+
+/** @struct SpritePart
+ *  Represent a hardware sprite of a metasprite.
+ *
+ *  @var SpritePart::dx
+ *    The x offset of the part from the position of the object.
+ *  @var SpritePart::dy
+ *    The y offset of the part from the position of the object.
+ *  @var SpritePart::tile
+ *    The tile of the part, from the first tile of the frame.
+ */
+typedef struct {
+    int8_t dx;
+    int8_t dy;
+    uint8_t tile;
+} SpritePart;
+
+/** @struct Metasprite
+ *  Represent the layout of a multi-tile sprite, shared by all its frames.
+ *
+ *  @var Metasprite::parts
+ *    The parts of the metasprite (in ROM).
+ *  @var Metasprite::count
+ *    The number of parts.
+ */
+typedef struct {
+    const SpritePart* parts;
+    uint8_t count;
+} Metasprite;
+
+/**
+ * @brief Give a metasprite to an object. The object takes the shadow OAM
+ * entries from oam to oam + metasprite->count - 1.
+ *
+ * @param object the object (one of SPRITE_OBJECTS)
+ * @param metasprite the layout of the object (in ROM)
+ * @param oam the first shadow OAM entry of the object
+ */
+void SetSpriteObject(uint8_t object, const Metasprite* metasprite,
+                     uint8_t oam);
+
+/**
+ * @brief Move an object to the absolute x and y positions (OAM coordinates).
+ *
+ * @param object the object (one of SPRITE_OBJECTS)
+ * @param x the x position
+ * @param y the y position
+ */
+void MoveSpriteObject(uint8_t object, uint8_t x, uint8_t y);
+
+/**
+ * @brief Move an object by relative x and y offsets.
+ *
+ * @param object the object (one of SPRITE_OBJECTS)
+ * @param x the x offset
+ * @param y the y offset
+ */
+void ScrollSpriteObject(uint8_t object, int8_t x, int8_t y);
+
+/**
+ * @brief Set the frame of an object.
+ *
+ * @param object the object (one of SPRITE_OBJECTS)
+ * @param tile the first tile of the frame
+ */
+void SetSpriteObjectTile(uint8_t object, uint8_t tile);
+
+/**
+ * @brief Write the objects changed since the last call to the shadow OAM.
+ * Called once per frame, after the sprite changes of the frame: the DMA of
+ * the next VBlank shows them all at once.
+ *
+ */
+void UpdateSprites();
+
+#endif
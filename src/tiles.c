@@ -0,0 +1,141 @@
+#include "tiles.h"
+
+#include <resources/sets_packed.h>
+
+#include "unpack.h"
+
+// the tile lists are read from their bank, so this file must stay in the
+// fixed bank 0
+
+/** the number of bytes of a 2bpp tile */
+#define TILE_BYTES 16
+
+/** the png index of a free slot */
+#define NO_TILE 0xFF
+
+/*************************************************
+**               private variables              **
+*************************************************/
+
+/** the slot of every tile of the png, or NO_TILE_SLOT */
+uint8_t tileSlots[sets_TILE_COUNT];
+
+/** the tile in every slot, or NO_TILE, and the number of acquired sets that
+ * have it. A slot without any set keeps its tile until it is given away. */
+uint8_t slotTiles[TILE_SLOT_COUNT];
+uint8_t slotRefs[TILE_SLOT_COUNT];
+
+/** the tile of the set that is skipped (it already has a slot) */
+uint8_t skippedTile[TILE_BYTES];
+
+/*************************************************
+**             private functions                **
+*************************************************/
+
+/**
+ * @brief Find a slot for a new tile: an empty one, or else the first one
+ * without any set. There is always one, as every tile set fits the slots
+ * together (checked by scripts/pack.py).
+ *
+ * @return the slot
+ */
+uint8_t FindFreeSlot()
+{
+    uint8_t freeSlot = NO_TILE_SLOT;
+
+    for (uint8_t slot = 0; slot < TILE_SLOT_COUNT; slot++) {
+        if (slotRefs[slot]) continue;
+        if (slotTiles[slot] == NO_TILE) return slot;
+        if (freeSlot == NO_TILE_SLOT) freeSlot = slot;
+    }
+
+    return freeSlot;
+}
+
+/*************************************************
+**               public functions               **
+*************************************************/
+
+void InitTileSlots()
+{
+    for (uint8_t i = 0; i < sets_TILE_COUNT; i++) tileSlots[i] = NO_TILE_SLOT;
+
+    for (uint8_t slot = 0; slot < TILE_SLOT_COUNT; slot++) {
+        slotTiles[slot] = NO_TILE;
+        slotRefs[slot] = 0;
+    }
+}
+
+void AcquireTileSet(const TileSet* set, uint8_t bank)
+{
+    Unpacker unpacker;
+    StartUnpack(&unpacker, bank, set->packed);
+
+    // the new tiles of consecutive slots are staged, then copied together
+    uint8_t* staged = StageTiles();
+    uint8_t stagedSlot = 0;
+    uint8_t stagedCount = 0;
+
+    for (uint8_t i = 0; i < set->count; i++) {
+        uint8_t previousBank = CURRENT_BANK;
+        SWITCH_ROM(bank);
+        uint8_t tile = set->tiles[i];
+        SWITCH_ROM(previousBank);
+
+        uint8_t slot = tileSlots[tile];
+
+        // the stream is read through: the loaded tiles are skipped
+        if (slot != NO_TILE_SLOT) {
+            Unpack(&unpacker, skippedTile, TILE_BYTES);
+            slotRefs[slot]++;
+            continue;
+        }
+
+        slot = FindFreeSlot();
+
+        // the previous tile of the slot is given away
+        if (slotTiles[slot] != NO_TILE)
+            tileSlots[slotTiles[slot]] = NO_TILE_SLOT;
+
+        slotTiles[slot] = tile;
+        tileSlots[tile] = slot;
+
+        // a slot that does not follow the staged ones starts a new copy
+        if (stagedCount && (slot != stagedSlot + stagedCount ||
+                            stagedCount == UNPACK_TILE_COUNT)) {
+            QueueStagedTiles(BKG_TILE_DATA(stagedSlot), stagedCount);
+            staged = StageTiles();
+            stagedCount = 0;
+        }
+
+        if (stagedCount == 0) stagedSlot = slot;
+        Unpack(&unpacker, staged + stagedCount * TILE_BYTES, TILE_BYTES);
+        stagedCount++;
+
+        slotRefs[slot]++;
+    }
+
+    if (stagedCount) QueueStagedTiles(BKG_TILE_DATA(stagedSlot), stagedCount);
+}
+
+void ReleaseTileSet(const TileSet* set, uint8_t bank)
+{
+    uint8_t previousBank = CURRENT_BANK;
+    SWITCH_ROM(bank);
+
+    // every tile of an acquired set has a slot
+    for (uint8_t i = 0; i < set->count; i++)
+        slotRefs[tileSlots[set->tiles[i]]]--;
+
+    SWITCH_ROM(previousBank);
+}
+
+uint8_t GetTileSlot(uint8_t tile)
+{
+    return tileSlots[tile];
+}
+
+void MapTileSlots(uint8_t* tiles, uint16_t count)
+{
+    for (; count; count--, tiles++) *tiles = tileSlots[*tiles];
+}
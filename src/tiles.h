@@ -0,0 +1,89 @@
+/**
+ * @file tiles.h
+ * @author Raphael Jouretz (rjouretz.com)
+ * @brief Give VRAM slots to the background tiles of sets.bkg.png. Every
+ * screen acquires the tile set it shows: only its tiles without a slot are
+ * loaded, and a slot is reused once no acquired set has its tile. The maps
+ * hold the png indices of the tiles, replaced by their slots before they are
+ * written to VRAM.
+ * @version 0.1
+ * @date 2023-06-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <gb/gb.h>
+#include <stdint.h>
+#include <types.h>
+
+#ifndef TILES_H
+#define TILES_H
+
+/** the number of background tile slots: the 0x9000 block, the 0x8800 one is
+ * left to the sprites */
+#define TILE_SLOT_COUNT 128
+
+/** the slot of a tile without one */
+#define NO_TILE_SLOT 0xFF
+
+/** @struct TileSet
+ *  Represent the tiles a screen shows, generated by scripts/pack.py in the
+ *  bank of the packed tiles.
+ *
+ *  @var TileSet::tiles
+ *    The png indices of the tiles, from the lowest.
+ *  @var TileSet::packed
+ *    The packed tiles, in the order of the indices.
+ *  @var TileSet::count
+ *    The number of tiles.
+ */
+typedef struct {
+    const uint8_t* tiles;
+    const uint8_t* packed;
+    uint8_t count;
+} TileSet;
+
+/**
+ * @brief Set every slot free. Must be called before any other tile slot
+ * function.
+ *
+ */
+void InitTileSlots();
+
+/**
+ * @brief Acquire the tiles of a set: the tiles without a slot are loaded in
+ * free slots. A screen acquires its next set before it releases the one in
+ * view, so scripts/pack.py fails the build unless the tiles of all the sets
+ * fit in TILE_SLOT_COUNT.
+ *
+ * @param set a pointer to a TileSet (in ROM)
+ * @param bank the ROM bank of the tile set
+ */
+void AcquireTileSet(const TileSet* set, uint8_t bank);
+
+/**
+ * @brief Release the tiles of an acquired set. They stay in their slots
+ * until the slots are given to other tiles.
+ *
+ * @param set a pointer to an acquired TileSet
+ * @param bank the ROM bank of the tile set
+ */
+void ReleaseTileSet(const TileSet* set, uint8_t bank);
+
+/**
+ * @brief Get the slot of a tile of an acquired set.
+ *
+ * @param tile the png index of the tile
+ * @return the slot, NO_TILE_SLOT if the tile is not loaded
+ */
+uint8_t GetTileSlot(uint8_t tile);
+
+/**
+ * @brief Replace png indices by the slots of their tiles.
+ *
+ * @param tiles the indices (in WRAM)
+ * @param count the number of indices
+ */
+void MapTileSlots(uint8_t* tiles, uint16_t count);
+
+#endif
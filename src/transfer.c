@@ -0,0 +1,176 @@
+#include "transfer.h"
+
+#include <stddef.h>
+
+/** the queue indices count up and wrap, the mask gives the entry */
+#define TRANSFER_INDEX_MASK (TRANSFER_QUEUE_SIZE - 1)
+
+#if TRANSFER_QUEUE_SIZE & TRANSFER_INDEX_MASK
+#error "TRANSFER_QUEUE_SIZE is not a power of 2"
+#endif
+
+/*************************************************
+**                 structures                   **
+*************************************************/
+
+/** @struct QueuedTransfer
+ *  Represent a transfer in the queue and its progress.
+ *
+ *  @var QueuedTransfer::transfer
+ *    The transfer: dest and src move to the next byte to copy and height
+ *    counts the rows left, the current one included.
+ *  @var QueuedTransfer::column
+ *    The number of bytes left in the current row.
+ *  @var QueuedTransfer::size
+ *    The number of bytes of the transfer.
+ *  @var QueuedTransfer::reported
+ *    The number of copied bytes given to the last onProgress.
+ */
+typedef struct {
+    Transfer transfer;
+    uint8_t column;
+    uint16_t size;
+    uint16_t reported;
+} QueuedTransfer;
+
+/*************************************************
+**               private variables              **
+*************************************************/
+
+QueuedTransfer transferQueue[TRANSFER_QUEUE_SIZE];
+
+/** the next transfer to report, the next one to copy and the next free
+ * entry. The entries from transferReport to transferCopy are copied but not
+ * reported yet. */
+volatile uint8_t transferReport;
+volatile uint8_t transferCopy;
+volatile uint8_t transferEnd;
+
+/*************************************************
+**             private functions                **
+*************************************************/
+
+/**
+ * @brief Copy the next bytes of the queue while VRAM can be written. The
+ * HBlank interrupt is turned off once the queue is copied.
+ *
+ * @param budget the maximum number of bytes to copy
+ */
+void CopyTransfers(uint8_t budget)
+{
+    while (budget && transferCopy != transferEnd) {
+        QueuedTransfer* queued =
+            &transferQueue[transferCopy & TRANSFER_INDEX_MASK];
+        Transfer* transfer = &queued->transfer;
+
+        // the row is copied with local pointers, stored back once
+        uint8_t* dest = transfer->dest;
+        const uint8_t* src = transfer->src;
+        uint8_t column = queued->column;
+
+        for (; budget && column; budget--, column--) {
+            // VRAM is free in HBlank and VBlank, and a HBlank is followed by
+            // the OAM scan, long enough for the write after the check
+            if (STAT_REG & STATF_BUSY) break;
+
+            *dest++ = *src++;
+        }
+
+        transfer->dest = dest;
+        transfer->src = src;
+        queued->column = column;
+
+        if (column) return;
+
+        transfer->dest += transfer->destStride - transfer->width;
+        transfer->src += transfer->srcStride - transfer->width;
+
+        if (--transfer->height)
+            queued->column = transfer->width;
+        else
+            transferCopy++;
+    }
+
+    if (transferCopy == transferEnd) STAT_REG &= ~STATF_MODE00;
+}
+
+/**
+ * @brief The LCD handler: copy a few bytes in the HBlank of a line.
+ *
+ */
+void CopyInHBlank()
+{
+    CopyTransfers(TRANSFER_HBLANK_BUDGET);
+}
+
+/**
+ * @brief The VBlank handler: copy a few bytes, then report the ended
+ * transfers and the progress of the current one.
+ *
+ */
+void CopyInVBlank()
+{
+    CopyTransfers(TRANSFER_VBLANK_BUDGET);
+
+    while (transferReport != transferCopy) {
+        QueuedTransfer* queued =
+            &transferQueue[transferReport++ & TRANSFER_INDEX_MASK];
+
+        if (queued->transfer.onDone)
+            queued->transfer.onDone(queued->size, queued->size);
+    }
+
+    if (transferCopy != transferEnd) {
+        QueuedTransfer* queued =
+            &transferQueue[transferCopy & TRANSFER_INDEX_MASK];
+        Transfer* transfer = &queued->transfer;
+
+        // the bytes left are the full rows after the current one and the
+        // rest of the current one
+        uint16_t done = queued->size - queued->column -
+                        (uint16_t)(transfer->height - 1) * transfer->width;
+
+        if (done != queued->reported && transfer->onProgress) {
+            queued->reported = done;
+            transfer->onProgress(done, queued->size);
+        }
+    }
+}
+
+/*************************************************
+**               public functions               **
+*************************************************/
+
+void InitTransfers()
+{
+    disable_interrupts();
+
+    transferReport = 0;
+    transferCopy = 0;
+    transferEnd = 0;
+    add_VBL(CopyInVBlank);
+    add_LCD(CopyInHBlank);
+    set_interrupts(IE_REG | LCD_IFLAG);
+
+    enable_interrupts();
+}
+
+void QueueTransfer(const Transfer* transfer)
+{
+    if (transfer->width == 0 || transfer->height == 0) return;
+
+    while ((uint8_t)(transferEnd - transferReport) == TRANSFER_QUEUE_SIZE)
+        wait_vbl_done();
+
+    QueuedTransfer* queued = &transferQueue[transferEnd & TRANSFER_INDEX_MASK];
+    queued->transfer = *transfer;
+    queued->column = transfer->width;
+    queued->size = (uint16_t)transfer->width * transfer->height;
+    queued->reported = 0;
+
+    // the HBlank interrupt only runs while there is something to copy
+    disable_interrupts();
+    transferEnd++;
+    STAT_REG |= STATF_MODE00;
+    enable_interrupts();
+}
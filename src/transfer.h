@@ -0,0 +1,96 @@
+/**
+ * @file transfer.h
+ * @author Raphael Jouretz (rjouretz.com)
+ * @brief Copy large blocks to VRAM with the LCD on. The queued transfers are
+ * copied a few bytes at a time in the HBlank of every line (STAT interrupt)
+ * and at VBlank, so a whole map loads in a frame or two without turning the
+ * LCD off or waiting for VRAM.
+ * @version 0.1
+ * @date 2023-06-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <gb/gb.h>
+#include <stdint.h>
+#include <types.h>
+
+#ifndef TRANSFER_H
+#define TRANSFER_H
+
+/**
+ * @defgroup TRANSFER_BUDGETS Transfer budgets
+ *
+ * @brief the number of bytes copied per interrupt
+ * @{
+ */
+/** per HBlank, at most: every byte checks that VRAM is free first, so a
+ * late interrupt copies less */
+#define TRANSFER_HBLANK_BUDGET 4
+/** per VBlank, after the board strip and the tile queue */
+#define TRANSFER_VBLANK_BUDGET 32
+/** @} */
+
+/** the maximum number of queued transfers (a power of 2) */
+#define TRANSFER_QUEUE_SIZE 4
+
+/**
+ * @brief A function called at VBlank with the progress of a transfer. It
+ * runs in the VBlank interrupt, so it must be short and must not queue a
+ * transfer.
+ *
+ * @param done the number of bytes copied
+ * @param size the number of bytes of the transfer
+ */
+typedef void (*TransferCallback)(uint16_t done, uint16_t size);
+
+/** @struct Transfer
+ *  Represent a block of rows to copy to VRAM. The source is read from the
+ *  interrupts, so it must be in WRAM or in ROM bank 0.
+ *
+ *  @var Transfer::dest
+ *    The VRAM address of the first byte of the block.
+ *  @var Transfer::src
+ *    The first byte to copy.
+ *  @var Transfer::width
+ *    The number of bytes of a row (1 to 255).
+ *  @var Transfer::height
+ *    The number of rows.
+ *  @var Transfer::destStride
+ *    The distance between two rows in VRAM (32 in a map).
+ *  @var Transfer::srcStride
+ *    The distance between two rows of the source.
+ *  @var Transfer::onProgress
+ *    Called at every VBlank the transfer went on without ending (can be
+ *    NULL).
+ *  @var Transfer::onDone
+ *    Called at the VBlank after the last byte is copied (can be NULL).
+ */
+typedef struct {
+    uint8_t* dest;
+    const uint8_t* src;
+    uint8_t width;
+    uint8_t height;
+    uint8_t destStride;
+    uint8_t srcStride;
+    TransferCallback onProgress;
+    TransferCallback onDone;
+} Transfer;
+
+/**
+ * @brief Add the transfer handlers to the VBlank and LCD interrupts. Must
+ * be called after the handlers that must run first, the transfers use the
+ * time they leave.
+ *
+ */
+void InitTransfers();
+
+/**
+ * @brief Queue a transfer, copied after the ones queued before it. Wait for
+ * a VBlank if the queue is full, so the interrupts must be enabled.
+ *
+ * @param transfer a pointer to a Transfer (copied)
+ */
+void QueueTransfer(const Transfer* transfer);
+
+#endif
@@ -0,0 +1,182 @@
+#include "unpack.h"
+
+#include <stddef.h>
+
+#include "transfer.h"
+
+// the unpacker switches the ROM bank while it reads, so this file must stay
+// in the fixed bank 0
+
+/** the number of bytes of a 2bpp tile */
+#define TILE_BYTES 16
+
+/** the number of staging buffers (a power of 2): one is unpacked while the
+ * others are copied */
+#define STAGE_BUFFER_COUNT 4
+
+#if STAGE_BUFFER_COUNT & (STAGE_BUFFER_COUNT - 1)
+#error "STAGE_BUFFER_COUNT is not a power of 2"
+#endif
+
+/*************************************************
+**               private variables              **
+*************************************************/
+
+/** the tiles being copied to VRAM, and the buffer StageTiles gives */
+uint8_t stagedTiles[STAGE_BUFFER_COUNT][UNPACK_TILE_COUNT * TILE_BYTES];
+uint8_t stageBuffer;
+
+/** the number of staged copies not reported done yet */
+volatile uint8_t stagedCopies;
+
+/*************************************************
+**             private functions                **
+*************************************************/
+
+/**
+ * @brief Read the head of the next run of a stream.
+ *
+ * @param unpacker a pointer to a started Unpacker
+ */
+void StartRun(Unpacker* unpacker)
+{
+    uint8_t head = *unpacker->packed++;
+
+    unpacker->kind = head & RUN_KIND_MASK;
+    unpacker->length = head & ~RUN_KIND_MASK;
+
+    // a double run writes every byte twice, the byte is read on the even
+    // lengths
+    if (unpacker->kind == RUN_DOUBLE)
+        unpacker->length <<= 1;
+    else if (unpacker->kind != RUN_LITERAL)
+        unpacker->value = *unpacker->packed++;
+}
+
+/**
+ * @brief The end of a staged copy, called at VBlank.
+ *
+ * @param done the number of bytes copied
+ * @param size the number of bytes of the copy
+ */
+void EndStagedCopy(uint16_t done, uint16_t size)
+{
+    stagedCopies--;
+}
+
+/**
+ * @brief Unpack tiles to the tile data, a few tiles at a time. A buffer is
+ * unpacked while the previous one is copied.
+ *
+ * @param dest the VRAM address of the first tile
+ * @param count the number of tiles
+ * @param bank the ROM bank of the packed tiles
+ * @param packed the packed tiles
+ */
+void UnpackData(uint8_t* dest, uint8_t count, uint8_t bank,
+                const uint8_t* packed)
+{
+    Unpacker unpacker;
+    StartUnpack(&unpacker, bank, packed);
+
+    while (count) {
+        uint8_t n = count < UNPACK_TILE_COUNT ? count : UNPACK_TILE_COUNT;
+
+        Unpack(&unpacker, StageTiles(), n * TILE_BYTES);
+        QueueStagedTiles(dest, n);
+
+        dest += n * TILE_BYTES;
+        count -= n;
+    }
+}
+
+/*************************************************
+**               public functions               **
+*************************************************/
+
+void StartUnpack(Unpacker* unpacker, uint8_t bank, const uint8_t* packed)
+{
+    unpacker->bank = bank;
+    unpacker->packed = packed;
+    unpacker->length = 0;
+}
+
+void Unpack(Unpacker* unpacker, uint8_t* data, uint16_t size)
+{
+    uint8_t previousBank = CURRENT_BANK;
+    SWITCH_ROM(unpacker->bank);
+
+    while (size) {
+        if (unpacker->length == 0) StartRun(unpacker);
+
+        // the part of the run that fits in the data
+        uint8_t count = size < unpacker->length ? size : unpacker->length;
+
+        unpacker->length -= count;
+        size -= count;
+
+        switch (unpacker->kind) {
+            case RUN_LITERAL:
+                for (; count; count--) *data++ = *unpacker->packed++;
+                break;
+
+            case RUN_REPEAT:
+                for (; count; count--) *data++ = unpacker->value;
+                break;
+
+            case RUN_INCREMENT:
+                for (; count; count--) *data++ = unpacker->value++;
+                break;
+
+            default: {
+                // the length left before the part tells where a pair starts
+                uint8_t length = unpacker->length + count;
+
+                for (; count; count--, length--) {
+                    if (!(length & 1)) unpacker->value = *unpacker->packed++;
+                    *data++ = unpacker->value;
+                }
+                break;
+            }
+        }
+    }
+
+    SWITCH_ROM(previousBank);
+}
+
+uint8_t* StageTiles()
+{
+    // the copies end in order: once fewer than the buffers are left, the
+    // copy of the next buffer has ended
+    while (stagedCopies >= STAGE_BUFFER_COUNT) wait_vbl_done();
+
+    return stagedTiles[stageBuffer];
+}
+
+void QueueStagedTiles(uint8_t* dest, uint8_t count)
+{
+    Transfer transfer;
+
+    transfer.dest = dest;
+    transfer.src = stagedTiles[stageBuffer];
+    transfer.width = count * TILE_BYTES;
+    transfer.height = 1;
+    transfer.destStride = 0;
+    transfer.srcStride = 0;
+    transfer.onProgress = NULL;
+    transfer.onDone = EndStagedCopy;
+
+    // counted before the copy can end
+    CRITICAL {
+        stagedCopies++;
+    }
+    QueueTransfer(&transfer);
+
+    stageBuffer = (stageBuffer + 1) & (STAGE_BUFFER_COUNT - 1);
+}
+
+void UnpackSpriteData(uint8_t first, uint8_t count, uint8_t bank,
+                      const uint8_t* packed)
+{
+    UnpackData(SPRITE_TILE_DATA(first), count, bank, packed);
+}
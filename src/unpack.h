@@ -0,0 +1,120 @@
+/**
+ * @file unpack.h
+ * @author Raphael Jouretz (rjouretz.com)
+ * @brief Unpack the tiles and maps packed at build time by scripts/pack.py
+ * while they are copied to VRAM. The packed data can be in any ROM bank: the
+ * bank is switched while the data is read, then the previous one is set back.
+ * The tiles are staged in WRAM and copied by the transfers (see transfer.h)
+ * @version 0.1
+ * @date 2023-06-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <gb/gb.h>
+#include <stdint.h>
+#include <types.h>
+
+#ifndef UNPACK_H
+#define UNPACK_H
+
+/**
+ * @defgroup PACKED_RUNS Packed runs
+ *
+ * @brief the kinds of run of a packed stream, in the 2 high bits of the
+ * first byte of the run (see scripts/pack.py)
+ * @{
+ */
+#define RUN_LITERAL   0x00
+#define RUN_REPEAT    0x40
+#define RUN_DOUBLE    0x80
+#define RUN_INCREMENT 0xC0
+#define RUN_KIND_MASK 0xC0
+/** @} */
+
+/** the number of tiles of a staging buffer */
+#define UNPACK_TILE_COUNT 8
+
+/**
+ * @defgroup TILE_DATA Tile data addresses
+ *
+ * @brief the VRAM address of a sprite tile, and of a background tile slot
+ * (the 0x9000 block, see tiles.h)
+ * @{
+ */
+#define SPRITE_TILE_DATA(tile) ((uint8_t*)_VRAM8000 + ((uint16_t)(tile) << 4))
+#define BKG_TILE_DATA(slot)    ((uint8_t*)_VRAM9000 + ((uint16_t)(slot) << 4))
+/** @} */
+
+/** @struct Unpacker
+ *  Represent a packed stream being unpacked. The runs can be unpacked in
+ *  pieces of any size.
+ *
+ *  @var Unpacker::bank
+ *    The ROM bank of the stream.
+ *  @var Unpacker::packed
+ *    The next byte of the stream.
+ *  @var Unpacker::kind
+ *    The kind of the current run (RUN_*).
+ *  @var Unpacker::length
+ *    The number of bytes left to write for the current run.
+ *  @var Unpacker::value
+ *    The next value of a RUN_REPEAT or RUN_INCREMENT run, or the value of
+ *    the current pair of a RUN_DOUBLE run.
+ */
+typedef struct {
+    uint8_t bank;
+    const uint8_t* packed;
+    uint8_t kind;
+    uint8_t length;
+    uint8_t value;
+} Unpacker;
+
+/**
+ * @brief Start to unpack a stream.
+ *
+ * @param unpacker a pointer to an Unpacker
+ * @param bank the ROM bank of the stream (BANK of its file)
+ * @param packed the packed stream (in ROM)
+ */
+void StartUnpack(Unpacker* unpacker, uint8_t bank, const uint8_t* packed);
+
+/**
+ * @brief Unpack the next bytes of a stream.
+ *
+ * @param unpacker a pointer to a started Unpacker
+ * @param data set to the unpacked bytes
+ * @param size the number of bytes to unpack (at most the bytes left)
+ */
+void Unpack(Unpacker* unpacker, uint8_t* data, uint16_t size);
+
+/**
+ * @brief Get the next staging buffer, UNPACK_TILE_COUNT tiles in WRAM to
+ * give to QueueStagedTiles. The buffers are used in turn, so it waits for
+ * the VBlank that ends the last copy of the buffer. The same buffer is
+ * returned until it is queued.
+ *
+ * @return the buffer
+ */
+uint8_t* StageTiles();
+
+/**
+ * @brief Queue the copy of the tiles of the buffer given by StageTiles.
+ *
+ * @param dest the VRAM address of the first tile (see TILE_DATA)
+ * @param count the number of tiles (1 to UNPACK_TILE_COUNT)
+ */
+void QueueStagedTiles(uint8_t* dest, uint8_t count);
+
+/**
+ * @brief Unpack tiles to the sprite tile data.
+ *
+ * @param first the index of the first tile
+ * @param count the number of tiles
+ * @param bank the ROM bank of the packed tiles
+ * @param packed the packed tiles
+ */
+void UnpackSpriteData(uint8_t first, uint8_t count, uint8_t bank,
+                      const uint8_t* packed);
+
+#endif
@@ -2,7 +2,72 @@
 
 #include <gb/gb.h>
 
+/*************************************************
+**               private variables              **
+*************************************************/
+
+/** incremented by the VBlank interrupt */
+volatile uint8_t vblankCount;
+
+/** the vblankCount of the last WaitFrame */
+uint8_t lastFrame;
+
+uint16_t lagFrameCount;
+
+/*************************************************
+**             private functions                **
+*************************************************/
+
+/**
+ * @brief Count the frames (VBlank handler)
+ *
+ */
+void CountFrame()
+{
+    vblankCount++;
+}
+
+/*************************************************
+**               public functions               **
+*************************************************/
+
+void InitFrameScheduler()
+{
+    disable_interrupts();
+
+    vblankCount = 0;
+    lastFrame = 0;
+    lagFrameCount = 0;
+    add_VBL(CountFrame);
+
+    enable_interrupts();
+}
+
+uint8_t WaitFrame()
+{
+    // a caller that lagged already missed the VBlank of its frame
+    while (vblankCount == lastFrame) wait_vbl_done();
+
+    // vblankCount is a single byte, its read cannot be split by the VBlank
+    uint8_t frames = vblankCount - lastFrame;
+    lastFrame += frames;
+
+    if (frames > 1) lagFrameCount += frames - 1;
+    if (frames > MAX_CATCH_UP_FRAMES) frames = MAX_CATCH_UP_FRAMES;
+
+    return frames;
+}
+
+uint16_t GetLagFrameCount()
+{
+    return lagFrameCount;
+}
+
 void Delay(uint16_t nbCycles)
 {
-    for (uint16_t i = 0; i < nbCycles; i++) wait_vbl_done();
-}
\ No newline at end of file
+    // counted with WaitFrame, so a delay is not seen as lag by the next frame
+    while (nbCycles) {
+        uint8_t frames = WaitFrame();
+        nbCycles -= frames < nbCycles ? frames : nbCycles;
+    }
+}
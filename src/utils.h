@@ -1,7 +1,7 @@
 /**
  * @file utils.h
  * @author Raphael Jouretz (rjouretz.com)
- * @brief Implement utility functions
+ * @brief Implement utility functions and the frame scheduler
  * @version 0.1
  * @date 2023-06-18
  *
@@ -16,6 +16,33 @@
 #define MAX_TILE_WIDTH  20
 #define MAX_TILE_HEIGHT 18
 
+/** the maximum number of frames WaitFrame asks to catch up, so a long
+ * stall does not turn into a burst of game ticks */
+#define MAX_CATCH_UP_FRAMES 4
+
+/**
+ * @brief Start to count the frames in the VBlank interrupt. Must be called
+ * once the VBlank interrupt is enabled (see InitSoundPlayer).
+ *
+ */
+void InitFrameScheduler();
+
+/**
+ * @brief Wait for the end of the current frame. The frames the caller
+ * overran (lag frames) are counted and given back to be caught up.
+ *
+ * @return the number of frames since the last call (1 if the caller did
+ * not lag), at most MAX_CATCH_UP_FRAMES
+ */
+uint8_t WaitFrame();
+
+/**
+ * @brief Get the number of lag frames since the start.
+ *
+ * @return the number of frames missed by the callers of WaitFrame
+ */
+uint16_t GetLagFrameCount();
+
 /**
  * @brief Blocking wait
  *